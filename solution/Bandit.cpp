@@ -0,0 +1,52 @@
+#include "Bandit.h"
+
+#include <algorithm>
+#include <cmath>
+
+OperatorBandit::OperatorBandit(const std::vector<std::string>& names, double decay, double explore)
+    : decay_(decay), explore_(explore)
+{
+    for (const auto& n : names) {
+        Arm a;
+        a.name = n;
+        arms_.push_back(a);
+    }
+}
+
+int OperatorBandit::Select()
+{
+    int best = -1;
+    double max_reward = 0.0;
+    for (int a = 0; a < arms() && best < 0; ++a) {
+        if (arms_[a].pulls + arms_[a].pending == 0) best = a;
+        // 待定拉动按零回报摊薄平均回报
+        max_reward = std::max(max_reward, arms_[a].reward * arms_[a].pulls / (arms_[a].pulls + arms_[a].pending));
+    }
+    if (best < 0) {
+        double best_score = -1.0;
+        const double log_total = std::log(static_cast<double>(total_ + pending_));
+        for (int a = 0; a < arms(); ++a) {
+            const double n = static_cast<double>(arms_[a].pulls + arms_[a].pending);
+            const double mean = arms_[a].reward * arms_[a].pulls / n;
+            double exploit = max_reward > 0.0 ? mean / max_reward : 0.0;
+            double score = exploit + explore_ * std::sqrt(log_total / n);
+            if (score > best_score) { best_score = score; best = a; }
+        }
+    }
+    ++arms_[best].pending;
+    ++pending_;
+    return best;
+}
+
+void OperatorBandit::Credit(int arm, long long gain, double ms)
+{
+    Arm& a = arms_[arm];
+    if (a.pending > 0) { --a.pending; --pending_; }
+    // 耗时下限 1 微秒，避免极快算子的回报被放大到无穷
+    double r = static_cast<double>(std::max(0LL, gain)) / std::max(ms, 1e-3);
+    a.reward = (a.pulls == 0) ? r : decay_ * a.reward + (1.0 - decay_) * r;
+    ++a.pulls;
+    a.gain += std::max(0LL, gain);
+    a.ms += ms;
+    ++total_;
+}
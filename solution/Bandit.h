@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// 多臂老虎机算子选择：臂的单次回报 = makespan 改进量 / 耗时（毫秒），按指数衰减平均，
+// 使信用随搜索阶段变化；选择用 UCB1：按最大平均回报归一化后的平均回报 + explore * sqrt(ln 总次数 / 该臂次数)，
+// 未试过的臂优先。Select 记一次待定拉动（virtual loss），对应的 Credit 到来前按零回报计入，
+// 同一代内连续选择（信用尚未返回）时会轮换到其他臂；每次 Select 都须有一次 Credit 与之对应
+class OperatorBandit {
+public:
+    OperatorBandit(const std::vector<std::string>& names, double decay, double explore);
+
+    int Select();
+    void Credit(int arm, long long gain, double ms);
+
+    int arms() const { return static_cast<int>(arms_.size()); }
+    const std::string& name(int arm) const { return arms_[arm].name; }
+    long long pulls(int arm) const { return arms_[arm].pulls; }
+    long long gain(int arm) const { return arms_[arm].gain; }
+    double ms(int arm) const { return arms_[arm].ms; }
+    double reward(int arm) const { return arms_[arm].reward; }
+
+private:
+    struct Arm {
+        std::string name;
+        double reward = 0.0;  // 衰减平均的 改进量/毫秒
+        long long pulls = 0;
+        long long pending = 0; // 已选择、尚未 Credit 的次数
+        long long gain = 0;   // 累计改进量
+        double ms = 0.0;      // 累计耗时
+    };
+    std::vector<Arm> arms_;
+    double decay_;
+    double explore_;
+    long long total_ = 0;
+    long long pending_ = 0;
+};
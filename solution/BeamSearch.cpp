@@ -0,0 +1,179 @@
+#include "BeamSearch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Simulator.h"
+
+namespace {
+
+struct BeamState {
+    SimSnapshot sim;
+    CowArray<int> indeg;                  // 剩余入度
+    CowArray<std::pair<int,int>> seq;     // 已调度序列
+    std::vector<int> ready;
+    long long path_lb = 0;                // max(完成时间 + rank 剩余量)，单调不减
+    long long sum_ready = 0;              // 各卡 ready 时间之和
+    long long remaining = 0;              // 未调度节点 exec 之和
+};
+
+struct Child {
+    int parent;
+    int nid;
+    int card;
+    long long end;
+    long long path_lb;
+    long long sum_ready;
+    long long score;
+};
+
+} // namespace
+
+std::vector<std::pair<int,int>> BeamSearchSchedule(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        const std::unordered_map<int,double>& rank_u,
+        int card_num,
+        int beam_width,
+        int expand_k,
+        std::chrono::high_resolution_clock::time_point deadline)
+{
+    if (card_num <= 0 || beam_width <= 0 || expand_k <= 0) return {};
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+    const int n = static_cast<int>(indeg0.size());
+    if (n == 0) return {};
+
+    // rank 剩余量：节点完成后沿 upward-rank 估计还需的时间
+    std::vector<long long> rank_tail(m, 0), rank_full(m, 0), succ_dr(m, 0);
+    std::vector<double> rank(m, 0.0);
+    for (const auto& kv : rank_u) {
+        if (kv.first < 0 || kv.first >= m || !nodes[kv.first]) continue;
+        rank[kv.first] = kv.second;
+        rank_full[kv.first] = std::llround(kv.second);
+        rank_tail[kv.first] = std::max(0LL, rank_full[kv.first] - nodes[kv.first]->exec_time());
+    }
+
+    std::vector<BeamState> beam(1), next_beam;
+    {
+        BeamState& root = beam[0];
+        root.sim.Reset(card_num, m);
+        root.indeg.Assign(m, 0);
+        for (const auto& kv : indeg0) {
+            root.indeg.Set(kv.first, kv.second);
+            if (kv.second == 0) root.ready.push_back(kv.first);
+            root.remaining += nodes[kv.first]->exec_time();
+        }
+    }
+
+    std::vector<Child> children;
+    std::vector<int> cand_nodes;
+    std::vector<std::pair<long long,int>> card_ends;
+    const int card_k = std::min(2, card_num);
+    for (int step = 0; step < n; ++step) {
+        if ((step & 15) == 0 && std::chrono::high_resolution_clock::now() >= deadline) return {};
+        children.clear();
+        for (int b = 0; b < static_cast<int>(beam.size()); ++b) {
+            const BeamState& st = beam[b];
+            if (st.ready.empty()) continue;
+            // 取 rank 最高的 expand_k 个就绪节点
+            cand_nodes = st.ready;
+            auto by_rank = [&](int x, int y){ return rank[x] != rank[y] ? rank[x] > rank[y] : x < y; };
+            if (static_cast<int>(cand_nodes.size()) > expand_k) {
+                std::nth_element(cand_nodes.begin(), cand_nodes.begin() + expand_k, cand_nodes.end(), by_rank);
+                cand_nodes.resize(expand_k);
+            }
+            // 就绪但未调度节点的下界：max(数据就绪, 最早空闲卡) + rank，取前两大以便排除被选中的节点
+            long long min_ready = *std::min_element(st.sim.card_ready.begin(), st.sim.card_ready.end());
+            long long f1 = 0, f2 = 0;
+            int f1_node = -1;
+            for (int v : st.ready) {
+                long long dr = 0;
+                for (const Node* pred : nodes[v]->inputs()) if (pred) dr = std::max(dr, st.sim.Finish(static_cast<int>(pred->id())));
+                long long val = std::max(dr, min_ready) + rank_full[v];
+                if (val > f1) { f2 = f1; f1 = val; f1_node = v; }
+                else if (val > f2) { f2 = val; }
+            }
+            for (int v : cand_nodes) {
+                long long frontier = (v == f1_node) ? f2 : f1;
+                // 选中 v 后新就绪的后继
+                auto jt = adj.find(v);
+                if (jt != adj.end()) {
+                    for (int s : jt->second) {
+                        if (st.indeg.Get(s) != 1) continue;
+                        long long dr = 0;
+                        for (const Node* pred : nodes[s]->inputs()) {
+                            if (pred && static_cast<int>(pred->id()) != v) dr = std::max(dr, st.sim.Finish(static_cast<int>(pred->id())));
+                        }
+                        succ_dr[s] = dr;
+                    }
+                }
+                card_ends.clear();
+                for (int c = 0; c < card_num; ++c) card_ends.emplace_back(st.sim.EvalEnd(nodes[v], c), c);
+                std::partial_sort(card_ends.begin(), card_ends.begin() + card_k, card_ends.end());
+                for (int k = 0; k < card_k; ++k) {
+                    long long end = card_ends[k].first;
+                    int c = card_ends[k].second;
+                    long long path = std::max(st.path_lb, end + rank_tail[v]);
+                    path = std::max(path, frontier);
+                    if (jt != adj.end()) {
+                        for (int s2 : jt->second) {
+                            if (st.indeg.Get(s2) == 1) path = std::max(path, std::max(succ_dr[s2], end) + rank_full[s2]);
+                        }
+                    }
+                    long long sum_ready = st.sum_ready - st.sim.card_ready[c] + end;
+                    long long load = (sum_ready + st.remaining - nodes[v]->exec_time() + card_num - 1) / card_num;
+                    children.push_back({b, v, c, end, path, sum_ready, std::max(path, load)});
+                }
+            }
+        }
+        if (children.empty()) break;
+        auto better = [&](const Child& x, const Child& y){
+            if (x.score != y.score) return x.score < y.score;
+            if (rank[x.nid] != rank[y.nid]) return rank[x.nid] > rank[y.nid];
+            if (x.sum_ready != y.sum_ready) return x.sum_ready < y.sum_ready;
+            if (x.end != y.end) return x.end < y.end;
+            if (x.parent != y.parent) return x.parent < y.parent;
+            if (x.nid != y.nid) return x.nid < y.nid;
+            return x.card < y.card;
+        };
+        int keep = std::min(beam_width, static_cast<int>(children.size()));
+        std::partial_sort(children.begin(), children.begin() + keep, children.end(), better);
+
+        // 物化选中的子状态：拷贝父状态只复制块指针，提交时才复制被改写的块
+        next_beam.clear();
+        for (int i = 0; i < keep; ++i) {
+            const Child& ch = children[i];
+            next_beam.push_back(beam[ch.parent]);
+            BeamState& st = next_beam.back();
+            st.sim.Commit(nodes[ch.nid], ch.card);
+            st.seq.PushBack({ch.nid, ch.card});
+            st.path_lb = ch.path_lb;
+            st.sum_ready = ch.sum_ready;
+            st.remaining -= nodes[ch.nid]->exec_time();
+            auto it = std::find(st.ready.begin(), st.ready.end(), ch.nid);
+            *it = st.ready.back();
+            st.ready.pop_back();
+            auto jt = adj.find(ch.nid);
+            if (jt != adj.end()) {
+                for (int s : jt->second) {
+                    int d = st.indeg.Get(s) - 1;
+                    st.indeg.Set(s, d);
+                    if (d == 0) st.ready.push_back(s);
+                }
+            }
+        }
+        beam.swap(next_beam);
+    }
+
+    const BeamState* best = nullptr;
+    for (const auto& st : beam) {
+        if (st.seq.size() != n) continue;
+        if (!best || st.sim.Makespan() < best->sim.Makespan()) best = &st;
+    }
+    if (!best) return {};
+    std::vector<std::pair<int,int>> order(n);
+    for (int i = 0; i < n; ++i) order[i] = best->seq.Get(i);
+    return order;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 束搜索列表调度：每步保留 beam_width 个最优部分调度，
+// 评分 = max(已调度节点完成时间 + upward-rank 剩余量, 就绪节点最早开始 + upward-rank, 负载下界)，
+// 并列时偏向 rank 更高的节点（退化为 HEFT）。
+// 每个部分调度扩展 upward-rank 最高的 expand_k 个就绪节点，每个节点尝试 EFT 最优的两张卡；
+// 部分调度之间通过写时复制的 SimSnapshot 共享状态。beam_width 越大质量越好、耗时越长；
+// 超过 deadline 时放弃并返回空
+std::vector<std::pair<int,int>> BeamSearchSchedule(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    const std::unordered_map<int,double>& rank_u,
+    int card_num,
+    int beam_width,
+    int expand_k,
+    std::chrono::high_resolution_clock::time_point deadline = std::chrono::high_resolution_clock::time_point::max());
@@ -0,0 +1,178 @@
+#include "Components.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include "GAInit.h"
+#include "Simulator.h"
+
+UnionFind::UnionFind(int n) : parent_(n), size_(n, 1) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+}
+
+int UnionFind::Find(int x) {
+    while (parent_[x] != x) {
+        parent_[x] = parent_[parent_[x]];
+        x = parent_[x];
+    }
+    return x;
+}
+
+void UnionFind::Union(int a, int b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) return;
+    if (size_[a] < size_[b]) std::swap(a, b);
+    parent_[b] = a;
+    size_[a] += size_[b];
+}
+
+std::vector<std::vector<int>> WeakComponents(const std::vector<Node*>& nodes)
+{
+    const int n = static_cast<int>(nodes.size());
+    UnionFind uf(n);
+    for (const Node* v : nodes) {
+        if (!v) continue;
+        for (const Node* p : v->inputs()) if (p) uf.Union(static_cast<int>(v->id()), static_cast<int>(p->id()));
+    }
+    std::vector<int> comp_of(n, -1);
+    std::vector<std::vector<int>> comps;
+    for (int v = 0; v < n; ++v) {
+        if (!nodes[v]) continue;
+        int r = uf.Find(v);
+        if (comp_of[r] < 0) {
+            comp_of[r] = static_cast<int>(comps.size());
+            comps.emplace_back();
+        }
+        comps[comp_of[r]].push_back(v);
+    }
+    return comps;
+}
+
+ContractedGraph InducedSubgraph(const std::vector<const Node*>& nodes, const std::vector<int>& ids)
+{
+    ContractedGraph g;
+    std::unordered_map<int,int> local;
+    local.reserve(ids.size());
+    for (int i = 0; i < static_cast<int>(ids.size()); ++i) local[ids[i]] = i;
+    g.owned.reserve(ids.size());
+    for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+        g.owned.emplace_back(new Node());
+        g.nodes.push_back(g.owned.back().get());
+        g.members.push_back({ids[i]});
+    }
+    // 全部编号后再补齐输入（子图内输入的编号未必更小）
+    for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+        const Node* v = nodes[ids[i]];
+        std::vector<Node*> inputs;
+        for (const Node* p : v->inputs()) {
+            auto it = p ? local.find(static_cast<int>(p->id())) : local.end();
+            if (it != local.end()) inputs.push_back(g.nodes[it->second]);
+        }
+        *g.owned[i] = Node(static_cast<size_t>(i), inputs, v->exec_time(), v->transfer_time());
+    }
+    return g;
+}
+
+std::vector<std::pair<int,int>> MergeComponentSchedules(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        const std::vector<std::vector<std::pair<int,int>>>& parts,
+        int card_num)
+{
+    if (card_num <= 0) return {};
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+
+    // 各子调度独立模拟，得到开始时间与本地卡负载
+    std::vector<double> start(m, 0.0);
+    std::vector<std::vector<long long>> local_load(parts.size(), std::vector<long long>(card_num, 0));
+    std::vector<long long> part_load(parts.size(), 0);
+    SimState st;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        st.Reset(card_num, m);
+        for (const auto& p : parts[i]) {
+            const Node* node = nodes[p.first];
+            st.Commit(node, p.second);
+            start[p.first] = static_cast<double>(st.finish_time[p.first] - node->exec_time());
+            local_load[i][p.second] += node->exec_time();
+            part_load[i] += node->exec_time();
+        }
+    }
+
+    // LPT：重的子调度先选卡，本地重卡对应全局轻卡
+    std::vector<int> by_load(parts.size());
+    std::iota(by_load.begin(), by_load.end(), 0);
+    std::stable_sort(by_load.begin(), by_load.end(), [&](int a, int b){ return part_load[a] > part_load[b]; });
+    std::vector<long long> global_load(card_num, 0);
+    std::unordered_map<int,int> cards;
+    std::unordered_map<int,double> prio;
+    cards.reserve(indeg0.size());
+    prio.reserve(indeg0.size());
+    std::vector<int> group_of(m, -1); // 共置组：(子调度, 本地卡)
+    std::vector<int> local_cards(card_num), global_cards(card_num), card_map(card_num);
+    for (int i : by_load) {
+        std::iota(local_cards.begin(), local_cards.end(), 0);
+        std::iota(global_cards.begin(), global_cards.end(), 0);
+        const auto& ll = local_load[i];
+        std::stable_sort(local_cards.begin(), local_cards.end(), [&](int a, int b){ return ll[a] > ll[b]; });
+        std::stable_sort(global_cards.begin(), global_cards.end(), [&](int a, int b){ return global_load[a] < global_load[b]; });
+        for (int c = 0; c < card_num; ++c) {
+            card_map[local_cards[c]] = global_cards[c];
+            global_load[global_cards[c]] += ll[local_cards[c]];
+        }
+        for (const auto& p : parts[i]) {
+            cards[p.first] = card_map[p.second];
+            prio[p.first] = start[p.first];
+            group_of[p.first] = static_cast<int>(i) * card_num + p.second;
+        }
+    }
+
+    // 候选一：LPT 卡映射；候选二：全局 EFT 选卡（LPT 卡仅作并列时的偏好）；
+    // 候选三：共置组在首个节点调度时按 EFT 选定全局卡，组内其余节点跟随。取模拟 makespan 最小者
+    CounterRng rng(0);
+    std::vector<std::vector<std::pair<int,int>>> cands;
+    cands.push_back(TopoByPriority(indeg0, adj, card_num, rng, prio, &cards));
+    cands.push_back(TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, prio, &cards));
+    {
+        using Key = std::pair<double,int>;
+        std::priority_queue<Key, std::vector<Key>, std::greater<Key>> ready; // 开始时间早者先出
+        std::unordered_map<int,int> indeg = indeg0;
+        for (const auto& kv : indeg) if (kv.second == 0) ready.push({start[kv.first], kv.first});
+        std::vector<int> group_card(parts.size() * card_num, -1);
+        std::vector<std::pair<int,int>> order;
+        order.reserve(indeg.size());
+        st.Reset(card_num, m);
+        while (!ready.empty()) {
+            int v = ready.top().second;
+            ready.pop();
+            int g = group_of[v];
+            int card = (g >= 0) ? group_card[g] : -1;
+            if (card < 0) {
+                long long best_end = -1;
+                for (int c = 0; c < card_num; ++c) {
+                    long long e = st.EvalEnd(nodes[v], c);
+                    if (best_end < 0 || e < best_end) { best_end = e; card = c; }
+                }
+                if (g >= 0) group_card[g] = card;
+            }
+            st.Commit(nodes[v], card);
+            order.emplace_back(v, card);
+            auto it = adj.find(v);
+            if (it == adj.end()) continue;
+            for (int s : it->second) if (--indeg[s] == 0) ready.push({start[s], s});
+        }
+        if (order.size() == indeg.size()) cands.push_back(std::move(order));
+    }
+    std::vector<std::pair<int,int>> best;
+    long long best_fit = -1;
+    for (auto& c : cands) {
+        if (c.empty()) continue;
+        long long fit = SimulateOrder(c, nodes, card_num);
+        if (best_fit < 0 || fit < best_fit) { best_fit = fit; best.swap(c); }
+    }
+    return best;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include "node.h"
+#include "Contract.h"
+
+// 并查集：按大小合并 + 路径减半
+class UnionFind {
+public:
+    explicit UnionFind(int n);
+    int Find(int x);
+    void Union(int a, int b);
+private:
+    std::vector<int> parent_;
+    std::vector<int> size_;
+};
+
+// 弱连通分量（忽略边方向），nodes 为按 id 下标的稠密节点表；每个分量内的 id 升序
+std::vector<std::vector<int>> WeakComponents(const std::vector<Node*>& nodes);
+
+// 诱导子图：ids 中的节点重新编号为 0..k-1，只保留子图内部的输入边。
+// members[i] = {ids[i]}，可直接用 ExpandChains 把子图执行序映射回原 id
+ContractedGraph InducedSubgraph(const std::vector<const Node*>& nodes, const std::vector<int>& ids);
+
+// 合并互相独立的若干子调度（原 id，各自从卡 0 开始编号）：
+// 子调度按总负载降序处理，其各本地卡按负载降序依次映射到当前负载最小的全局卡（LPT）；
+// 再以节点在各自独立调度中的开始时间为优先级做全局拓扑排序，使共享一张卡的子调度按时间交错
+std::vector<std::pair<int,int>> MergeComponentSchedules(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    const std::vector<std::vector<std::pair<int,int>>>& parts,
+    int card_num);
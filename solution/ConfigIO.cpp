@@ -0,0 +1,242 @@
+#include "ConfigIO.h"
+
+#include <cctype>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// 字段绑定：名称与按类型生成的读写函数
+struct FieldBinding {
+    const char* name;
+    std::function<bool(GAConfig&, const std::string&)> set;
+    std::function<std::string(const GAConfig&)> get;
+};
+
+bool ParseLong(const std::string& s, long long* out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    long long v = std::strtoll(s.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    *out = v;
+    return true;
+}
+
+bool ParseDouble(const std::string& s, double* out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    double v = std::strtod(s.c_str(), &end);
+    if (*end != '\0') return false;
+    *out = v;
+    return true;
+}
+
+const char* const kCrossoverNames[] = {"priority_eft", "ppx", "two_point", "card_uniform", "mix"};
+
+// 数值字段可带取值范围 [lo, hi]，越界与解析失败同样拒绝、保留原值
+FieldBinding Bind(const char* name, int GAConfig::* m, long long lo = INT_MIN, long long hi = INT_MAX) {
+    return {name,
+            [m, lo, hi](GAConfig& c, const std::string& v) {
+                long long x;
+                if (!ParseLong(v, &x) || x < lo || x > hi) return false;
+                c.*m = static_cast<int>(x);
+                return true;
+            },
+            [m](const GAConfig& c) { return std::to_string(c.*m); }};
+}
+
+FieldBinding Bind(const char* name, long long GAConfig::* m, long long lo = LLONG_MIN, long long hi = LLONG_MAX) {
+    return {name,
+            [m, lo, hi](GAConfig& c, const std::string& v) {
+                long long x;
+                if (!ParseLong(v, &x) || x < lo || x > hi) return false;
+                c.*m = x;
+                return true;
+            },
+            [m](const GAConfig& c) { return std::to_string(c.*m); }};
+}
+
+FieldBinding Bind(const char* name, double GAConfig::* m, double lo = -HUGE_VAL, double hi = HUGE_VAL) {
+    return {name,
+            [m, lo, hi](GAConfig& c, const std::string& v) {
+                double x;
+                if (!ParseDouble(v, &x) || !(x >= lo && x <= hi)) return false;
+                c.*m = x;
+                return true;
+            },
+            [m](const GAConfig& c) { std::ostringstream os; os << c.*m; return os.str(); }};
+}
+
+FieldBinding Bind(const char* name, bool GAConfig::* m) {
+    return {name,
+            [m](GAConfig& c, const std::string& v) {
+                if (v == "1" || v == "true") { c.*m = true; return true; }
+                if (v == "0" || v == "false") { c.*m = false; return true; }
+                return false;
+            },
+            [m](const GAConfig& c) { return std::string(c.*m ? "true" : "false"); }};
+}
+
+FieldBinding Bind(const char* name, CrossoverOp GAConfig::* m) {
+    return {name,
+            [m](GAConfig& c, const std::string& v) {
+                for (int i = 0; i <= static_cast<int>(CrossoverOp::kMix); ++i) {
+                    if (v == kCrossoverNames[i]) { c.*m = static_cast<CrossoverOp>(i); return true; }
+                }
+                return false;
+            },
+            [m](const GAConfig& c) { return std::string(kCrossoverNames[static_cast<int>(c.*m)]); }};
+}
+
+// 与 GAConfig 声明顺序一致；新增成员时需在此登记
+const std::vector<FieldBinding>& Fields() {
+    static const std::vector<FieldBinding> fields = {
+        Bind("pop_size", &GAConfig::pop_size, 3),
+        Bind("generations", &GAConfig::generations),
+        Bind("mutation_rate", &GAConfig::mutation_rate, 0, 1),
+        Bind("tournament_k", &GAConfig::tournament_k, 1),
+        Bind("prio_w_exec", &GAConfig::prio_w_exec),
+        Bind("prio_w_transfer", &GAConfig::prio_w_transfer),
+        Bind("prio_w_up_rank", &GAConfig::prio_w_up_rank),
+        Bind("prio_w_down_rank", &GAConfig::prio_w_down_rank),
+        Bind("prio_w_out_degree", &GAConfig::prio_w_out_degree),
+        Bind("prio_w_slack", &GAConfig::prio_w_slack),
+        Bind("seed", &GAConfig::seed),
+        Bind("rng_stream", &GAConfig::rng_stream),
+        Bind("fixed_work", &GAConfig::fixed_work),
+        Bind("max_evaluations", &GAConfig::max_evaluations),
+        Bind("lns_fixed_windows", &GAConfig::lns_fixed_windows),
+        Bind("verbose", &GAConfig::verbose),
+        Bind("auto_select", &GAConfig::auto_select),
+        Bind("greedy_seed", &GAConfig::greedy_seed),
+        Bind("partition_seed", &GAConfig::partition_seed),
+        Bind("deadline_ms", &GAConfig::deadline_ms),
+        Bind("deadline_reserve_share", &GAConfig::deadline_reserve_share, 0, 1),
+        Bind("deadline_gap", &GAConfig::deadline_gap),
+        Bind("deadline_safety", &GAConfig::deadline_safety),
+        Bind("stall_generations", &GAConfig::stall_generations),
+        Bind("stall_window_share", &GAConfig::stall_window_share, 0, 1),
+        Bind("stall_tolerance", &GAConfig::stall_tolerance),
+        Bind("chain_contraction", &GAConfig::chain_contraction),
+        Bind("chain_max_load_share", &GAConfig::chain_max_load_share, 0, 1),
+        Bind("comp_enabled", &GAConfig::comp_enabled),
+        Bind("comp_max_share", &GAConfig::comp_max_share, 0, 1),
+        Bind("comp_max_groups", &GAConfig::comp_max_groups),
+        Bind("comp_time_share", &GAConfig::comp_time_share, 0, 1),
+        Bind("ml_enabled", &GAConfig::ml_enabled),
+        Bind("ml_min_nodes", &GAConfig::ml_min_nodes),
+        Bind("ml_coarsest_nodes", &GAConfig::ml_coarsest_nodes),
+        Bind("ml_coarse_share", &GAConfig::ml_coarse_share, 0, 1),
+        Bind("canonical_cards", &GAConfig::canonical_cards),
+        Bind("fitness_cache_size", &GAConfig::fitness_cache_size),
+        Bind("crossover_op", &GAConfig::crossover_op),
+        Bind("bandit_enabled", &GAConfig::bandit_enabled),
+        Bind("bandit_decay", &GAConfig::bandit_decay, 0, 1),
+        Bind("bandit_explore", &GAConfig::bandit_explore),
+        Bind("surrogate_pool", &GAConfig::surrogate_pool),
+        Bind("surrogate_audit_interval", &GAConfig::surrogate_audit_interval),
+        Bind("surrogate_min_audits", &GAConfig::surrogate_min_audits),
+        Bind("beam_width", &GAConfig::beam_width),
+        Bind("beam_expand", &GAConfig::beam_expand),
+        Bind("beam_time_share", &GAConfig::beam_time_share, 0, 1),
+        Bind("cp_mutation_share", &GAConfig::cp_mutation_share, 0, 1),
+        Bind("cp_link_ratio", &GAConfig::cp_link_ratio, 0, 1),
+        Bind("fbj_enabled", &GAConfig::fbj_enabled),
+        Bind("fbj_max_iters", &GAConfig::fbj_max_iters),
+        Bind("pr_enabled", &GAConfig::pr_enabled),
+        Bind("pr_interval", &GAConfig::pr_interval),
+        Bind("pr_max_evals", &GAConfig::pr_max_evals),
+        Bind("lns_enabled", &GAConfig::lns_enabled),
+        Bind("lns_time_share", &GAConfig::lns_time_share, 0, 1),
+        Bind("lns_window", &GAConfig::lns_window, 1),
+        Bind("lns_node_limit", &GAConfig::lns_node_limit),
+        Bind("lns_leaf_limit", &GAConfig::lns_leaf_limit),
+    };
+    return fields;
+}
+
+std::string Trim(const std::string& s) {
+    size_t b = 0, e = s.size();
+    while (b < e && std::isspace(static_cast<unsigned char>(s[b]))) ++b;
+    while (e > b && std::isspace(static_cast<unsigned char>(s[e - 1]))) --e;
+    return s.substr(b, e - b);
+}
+
+} // namespace
+
+bool SetConfigField(GAConfig& cfg, const std::string& key, const std::string& value) {
+    for (const auto& f : Fields()) {
+        if (key == f.name) return f.set(cfg, value);
+    }
+    return false;
+}
+
+bool LoadConfigFile(const std::string& path, GAConfig& cfg, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error += path + ": cannot open\n";
+        return false;
+    }
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.resize(hash);
+        line = Trim(line);
+        if (line.empty()) continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos || !SetConfigField(cfg, Trim(line.substr(0, eq)), Trim(line.substr(eq + 1)))) {
+            if (error) *error += path + ":" + std::to_string(line_no) + ": bad entry '" + line + "'\n";
+        }
+    }
+    return true;
+}
+
+void ApplyConfigEnv(GAConfig& cfg, const std::string& graph_class, bool report_errors) {
+    std::string error;
+    if (const char* dir = std::getenv("EO_CONFIG_DIR")) {
+        // 类别配置可缺省：目录中没有该类别时保持默认
+        std::string path = std::string(dir) + "/" + graph_class + ".cfg";
+        if (std::ifstream(path)) LoadConfigFile(path, cfg, &error);
+    }
+    if (const char* path = std::getenv("EO_CONFIG")) LoadConfigFile(path, cfg, &error);
+    for (const auto& f : Fields()) {
+        std::string env = "EO_";
+        for (const char* p = f.name; *p; ++p) env += static_cast<char>(std::toupper(static_cast<unsigned char>(*p)));
+        const char* value = std::getenv(env.c_str());
+        if (value && !f.set(cfg, value)) error += env + ": bad or out-of-range value '" + value + "'\n";
+    }
+    if (!report_errors) return;
+    std::istringstream lines(error);
+    for (std::string line; std::getline(lines, line); ) std::cerr << "[Config] " << line << std::endl;
+}
+
+std::string FormatConfig(const GAConfig& cfg) {
+    std::string out;
+    for (const auto& f : Fields()) out += std::string(f.name) + " = " + f.get(cfg) + "\n";
+    return out;
+}
+
+std::string FormatConfig(const GAConfig& cfg, const std::vector<std::string>& names) {
+    std::string out;
+    for (const auto& name : names) {
+        for (const auto& f : Fields()) {
+            if (name == f.name) out += name + " = " + f.get(cfg) + "\n";
+        }
+    }
+    return out;
+}
+
+std::string GraphClass(const std::vector<Node*>& all_nodes) {
+    size_t n = all_nodes.size();
+    if (n < 200) return "tiny";
+    if (n < 2000) return "small";
+    if (n < 20000) return "medium";
+    return "large";
+}
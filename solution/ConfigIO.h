@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "GAConfig.h"
+#include "node.h"
+
+// 设置单个字段：key 为 GAConfig 成员名，value 按成员类型解析（bool 接受 0/1/true/false，
+// crossover_op 接受 priority_eft/ppx/two_point/card_uniform/mix）。未知键或无法解析时返回 false
+bool SetConfigField(GAConfig& cfg, const std::string& key, const std::string& value);
+
+// 读取配置文件：每行 key = value，# 之后为注释，空行忽略。
+// 文件无法打开返回 false；坏行跳过并写入 error（若非空），其余行照常生效
+bool LoadConfigFile(const std::string& path, GAConfig& cfg, std::string* error);
+
+// 按环境变量覆盖配置，依次为：
+// EO_CONFIG_DIR/<graph_class>.cfg（调参工具按图类别输出的配置）、EO_CONFIG 指定的文件、
+// 逐项的 EO_<大写成员名>（如 EO_POP_SIZE=8）。后者覆盖前者；report_errors 为 false 时不输出坏项
+void ApplyConfigEnv(GAConfig& cfg, const std::string& graph_class, bool report_errors = true);
+
+// 以 key = value 形式输出全部字段，可被 LoadConfigFile 读回
+std::string FormatConfig(const GAConfig& cfg);
+
+// 只输出 names 中列出的字段（按 names 顺序），未知名字忽略
+std::string FormatConfig(const GAConfig& cfg, const std::vector<std::string>& names);
+
+// 图类别：按节点数分为 tiny(<200) / small(<2000) / medium(<20000) / large，用于按类别选取调参结果
+std::string GraphClass(const std::vector<Node*>& all_nodes);
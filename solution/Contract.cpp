@@ -0,0 +1,73 @@
+#include "Contract.h"
+
+ContractedGraph ContractChains(const std::vector<Node*>& all_nodes, long long max_exec)
+{
+    ContractedGraph g;
+    const int n = static_cast<int>(all_nodes.size());
+    std::vector<int> out_deg(n, 0), next(n, -1);
+    for (const Node* v : all_nodes) {
+        if (!v) continue;
+        for (const Node* p : v->inputs()) if (p) out_deg[p->id()]++;
+    }
+    // 可收缩边 u->v：u 唯一消费者为 v，v 唯一输入为 u
+    std::vector<char> has_prev(n, 0);
+    for (const Node* v : all_nodes) {
+        if (!v || v->inputs().size() != 1 || !v->inputs()[0]) continue;
+        int u = static_cast<int>(v->inputs()[0]->id());
+        if (out_deg[u] != 1) continue;
+        next[u] = static_cast<int>(v->id());
+        has_prev[v->id()] = 1;
+    }
+
+    // 链上累计 exec 超过 max_exec 时断开，断点作为新链的链头
+    for (int h = 0; h < n; ++h) {
+        if (!all_nodes[h] || has_prev[h]) continue;
+        long long exec = all_nodes[h]->exec_time();
+        for (int v = next[h]; v >= 0; v = next[v]) {
+            exec += all_nodes[v]->exec_time();
+            if (exec > max_exec) { has_prev[v] = 0; exec = all_nodes[v]->exec_time(); }
+        }
+    }
+
+    // 每个链头生成一个超节点
+    std::vector<int> super_of(n, -1);
+    for (int h = 0; h < n; ++h) {
+        if (!all_nodes[h] || has_prev[h]) continue;
+        std::vector<int> chain{h};
+        long exec = all_nodes[h]->exec_time();
+        for (int v = next[h]; v >= 0 && has_prev[v]; v = next[v]) {
+            chain.push_back(v);
+            exec += all_nodes[v]->exec_time();
+        }
+        int sid = static_cast<int>(g.nodes.size());
+        for (int v : chain) super_of[v] = sid;
+        g.owned.emplace_back(new Node(static_cast<size_t>(sid), {}, exec,
+                                      all_nodes[chain.back()]->transfer_time()));
+        g.nodes.push_back(g.owned.back().get());
+        if (chain.size() >= 2) ++g.chains;
+        g.members.push_back(std::move(chain));
+    }
+    // 链头的输入属于尚未编号的链时无法直接引用，全部编号后再补齐输入
+    for (int s = 0; s < static_cast<int>(g.nodes.size()); ++s) {
+        std::vector<Node*> inputs;
+        for (const Node* p : all_nodes[g.members[s].front()]->inputs()) {
+            if (p) inputs.push_back(g.nodes[super_of[p->id()]]);
+        }
+        *g.owned[s] = Node(static_cast<size_t>(s), inputs, g.nodes[s]->exec_time(), g.nodes[s]->transfer_time());
+    }
+    return g;
+}
+
+std::vector<std::pair<size_t,size_t>> ExpandChains(
+        const ContractedGraph& graph,
+        const std::vector<std::pair<size_t,size_t>>& order)
+{
+    std::vector<std::pair<size_t,size_t>> result;
+    size_t total = 0;
+    for (const auto& m : graph.members) total += m.size();
+    result.reserve(total);
+    for (const auto& p : order) {
+        for (int v : graph.members[p.first]) result.emplace_back(static_cast<size_t>(v), p.second);
+    }
+    return result;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include "node.h"
+
+// 线性链收缩：边 u->v 满足 u 只有 v 一个消费者、v 只有 u 一个输入时，
+// 整条链合并成一个超节点（exec 求和，transfer 取链尾，输入取链头）。
+// 链内节点在执行序中连续放在同一张卡上时，超节点的模拟结果与逐个展开完全一致。
+struct ContractedGraph {
+    std::vector<std::unique_ptr<Node>> owned;
+    std::vector<Node*> nodes;              // 超节点，id 连续编号 0..k-1
+    std::vector<std::vector<int>> members; // 超节点 -> 原节点 id（链内顺序）
+    int chains = 0;                        // 长度 >= 2 的链数
+};
+
+// 原图节点 id 需连续（0..n-1）；单个超节点的 exec 总和不超过 max_exec（单节点本身超过时不合并），
+// 避免过长的链整段占住一张卡、挤掉其间本可插入的关键节点
+ContractedGraph ContractChains(const std::vector<Node*>& all_nodes, long long max_exec);
+
+// 把超节点执行序展开回原节点执行序（链内节点紧邻、同卡）
+std::vector<std::pair<size_t,size_t>> ExpandChains(
+    const ContractedGraph& graph,
+    const std::vector<std::pair<size_t,size_t>>& order);
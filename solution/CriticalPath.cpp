@@ -0,0 +1,116 @@
+#include "CriticalPath.h"
+
+#include <algorithm>
+#include "GAInit.h"
+
+std::vector<CriticalLink> ExtractCriticalChain(
+        const std::vector<std::pair<int,int>>& order,
+        const std::vector<const Node*>& nodes,
+        int card_num)
+{
+    const int n = static_cast<int>(order.size());
+    if (n == 0 || card_num <= 0) return {};
+    SimState st;
+    st.Reset(card_num, static_cast<int>(nodes.size()));
+    std::vector<SimBind> bind(n);
+    std::vector<int> prev_on_card(n, -1), prev_inbound(n, -1);
+    std::vector<int> last_pos(card_num, -1), last_inbound_pos(card_num, -1);
+    std::vector<int> pos_of(nodes.size(), -1);
+    for (int i = 0; i < n; ++i) {
+        int nid = order[i].first, c = order[i].second;
+        pos_of[nid] = i;
+        prev_on_card[i] = last_pos[c];
+        prev_inbound[i] = last_inbound_pos[c];
+        long long inbound_before = st.inbound_ready[c];
+        st.Commit(nodes[nid], c, nullptr, &bind[i]);
+        last_pos[c] = i;
+        if (st.inbound_ready[c] != inbound_before) last_inbound_pos[c] = i;
+    }
+    // 最晚结束的卡上最后一个节点即链尾
+    int end_card = static_cast<int>(std::max_element(st.card_ready.begin(), st.card_ready.end()) - st.card_ready.begin());
+    int cur = last_pos[end_card];
+
+    std::vector<CriticalLink> chain;
+    while (cur >= 0 && static_cast<int>(chain.size()) < n) {
+        int prev = -1;
+        switch (bind[cur].kind) {
+            case BindKind::kNone: prev = -1; break;
+            case BindKind::kCardBusy: prev = prev_on_card[cur]; break;
+            case BindKind::kInboundBusy: prev = prev_inbound[cur]; break;
+            case BindKind::kLocalDep:
+            case BindKind::kTransfer: prev = pos_of[bind[cur].from]; break;
+        }
+        chain.push_back({order[cur].first, cur, bind[cur].kind, prev >= 0 ? order[prev].first : -1});
+        cur = prev;
+    }
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+std::vector<std::pair<int,int>> CriticalPathMutate(
+        const std::vector<std::pair<int,int>>& indiv,
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num,
+        double link_ratio,
+        CounterRng& rng)
+{
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    auto chain = ExtractCriticalChain(indiv, nodes, card_num);
+    if (chain.empty()) return indiv;
+
+    std::unordered_map<int,double> prio;
+    std::unordered_map<int,int> cards;
+    prio.reserve(indiv.size());
+    cards.reserve(indiv.size());
+    for (size_t i = 0; i < indiv.size(); ++i) {
+        prio[indiv[i].first] = static_cast<double>(i);
+        cards[indiv[i].first] = indiv[i].second;
+    }
+
+    // 随机挑选部分关键环节做定向修改
+    std::vector<int> picks(chain.size());
+    for (size_t i = 0; i < picks.size(); ++i) picks[i] = static_cast<int>(i);
+    std::shuffle(picks.begin(), picks.end(), rng);
+    picks.resize(std::max<size_t>(1, static_cast<size_t>(chain.size() * link_ratio)));
+
+    std::uniform_real_distribution<double> shift(0.5, 3.0);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::vector<int> refine_nodes;
+    for (int k : picks) {
+        const CriticalLink& lk = chain[k];
+        switch (lk.kind) {
+            case BindKind::kTransfer:
+                // 传输在关键链上：与数据来源同卡以消除该传输
+                if (lk.from >= 0) cards[lk.node] = cards[lk.from];
+                break;
+            case BindKind::kInboundBusy:
+                refine_nodes.push_back(lk.node);
+                break;
+            case BindKind::kLocalDep:
+                // 前驱提前执行
+                if (lk.from >= 0) prio[lk.from] -= shift(rng);
+                break;
+            case BindKind::kCardBusy:
+                // 抢在本卡上一个节点之前，或换卡
+                if (lk.from >= 0 && coin(rng) == 0) prio[lk.node] = prio[lk.from] - shift(rng);
+                else refine_nodes.push_back(lk.node);
+                break;
+            case BindKind::kNone:
+                break;
+        }
+    }
+
+    auto child = TopoByPriority(indeg0, adj, card_num, rng, prio, &cards);
+    if (child.empty()) return indiv;
+    if (!refine_nodes.empty()) {
+        std::vector<int> pos_of(nodes.size(), -1);
+        for (size_t i = 0; i < child.size(); ++i) pos_of[child[i].first] = static_cast<int>(i);
+        std::vector<int> positions;
+        positions.reserve(refine_nodes.size());
+        for (int nid : refine_nodes) positions.push_back(pos_of[nid]);
+        child = RefineCardsAt(child, id2node, card_num, positions);
+    }
+    return child;
+}
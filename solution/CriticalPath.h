@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include "node.h"
+#include "Simulator.h"
+#include "Random.h"
+
+// 关键链上的一环：node 的开始时间由 kind 约束决定，from 为链上的前一个节点（-1 表示链首）
+struct CriticalLink {
+    int node;
+    int pos;       // node 在执行序中的位置
+    BindKind kind;
+    int from;
+};
+
+// 模拟 order，从最晚结束的节点沿开始时间的约束来源回溯，返回关键链（按执行先后）
+// 卡忙约束回溯到本卡上一个节点，入站通道忙回溯到上一个占用该通道的节点
+std::vector<CriticalLink> ExtractCriticalChain(
+    const std::vector<std::pair<int,int>>& order,
+    const std::vector<const Node*>& nodes,
+    int card_num);
+
+// 关键链定向变异：只扰动决定 makespan 的节点
+// 传输约束 -> 与数据来源同卡；同卡依赖 -> 提前前驱；卡忙 -> 提前自身或 EFT 重选卡
+std::vector<std::pair<int,int>> CriticalPathMutate(
+    const std::vector<std::pair<int,int>>& indiv,
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    double link_ratio,
+    CounterRng& rng);
@@ -0,0 +1,95 @@
+#include "Crossover.h"
+
+namespace {
+
+inline int MapCard(const std::vector<int>& perm_b, int card)
+{
+    return perm_b.empty() ? card : perm_b[card];
+}
+
+// 按 ws.from_a 掩码归并两个父代序列：每个位置取指定父代中下一个尚未放入的节点
+void MaskedMerge(const RowView& A,
+                 const RowView& B,
+                 const std::vector<int>& perm_b,
+                 CrossoverWorkspace& ws,
+                 std::vector<std::pair<int,int>>& child)
+{
+    const size_t n = A.size();
+    ws.taken.assign(n, 0);
+    child.clear();
+    child.reserve(n);
+    size_t ia = 0, ib = 0;
+    for (size_t k = 0; k < n; ++k) {
+        if (ws.from_a[k]) {
+            while (ws.taken[A[ia].first]) ++ia;
+            ws.taken[A[ia].first] = 1;
+            child.push_back(A[ia]);
+        } else {
+            while (ws.taken[B[ib].first]) ++ib;
+            const auto b = B[ib];
+            ws.taken[b.first] = 1;
+            child.emplace_back(b.first, MapCard(perm_b, b.second));
+        }
+    }
+}
+
+} // namespace
+
+void PrecedencePreservingCrossover(
+        const RowView& A,
+        const RowView& B,
+        const std::vector<int>& perm_b,
+        CounterRng& rng,
+        CrossoverWorkspace& ws,
+        std::vector<std::pair<int,int>>& child)
+{
+    const size_t n = A.size();
+    ws.from_a.resize(n);
+    // 每次取 32 位随机数分给 32 个位置
+    for (size_t k = 0; k < n; k += 32) {
+        unsigned bits = static_cast<unsigned>(rng());
+        for (size_t j = k; j < n && j < k + 32; ++j, bits >>= 1) ws.from_a[j] = static_cast<char>(bits & 1u);
+    }
+    MaskedMerge(A, B, perm_b, ws, child);
+}
+
+void TwoPointOrderCrossover(
+        const RowView& A,
+        const RowView& B,
+        const std::vector<int>& perm_b,
+        CounterRng& rng,
+        CrossoverWorkspace& ws,
+        std::vector<std::pair<int,int>>& child)
+{
+    const size_t n = A.size();
+    std::uniform_int_distribution<size_t> cut(0, n);
+    size_t p1 = cut(rng), p2 = cut(rng);
+    if (p1 > p2) std::swap(p1, p2);
+    ws.from_a.assign(n, 1);
+    for (size_t k = p1; k < p2; ++k) ws.from_a[k] = 0;
+    MaskedMerge(A, B, perm_b, ws, child);
+}
+
+void CardUniformCrossover(
+        const RowView& A,
+        const RowView& B,
+        const std::vector<int>& perm_b,
+        CounterRng& rng,
+        CrossoverWorkspace& ws,
+        std::vector<std::pair<int,int>>& child)
+{
+    const size_t n = A.size();
+    ws.card_b.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto p = B[i];
+        ws.card_b[p.first] = MapCard(perm_b, p.second);
+    }
+    child.resize(n);
+    for (size_t i = 0; i < n; ++i) child[i] = A[i];
+    for (size_t k = 0; k < n; k += 32) {
+        unsigned bits = static_cast<unsigned>(rng());
+        for (size_t j = k; j < n && j < k + 32; ++j, bits >>= 1) {
+            if (bits & 1u) child[j].second = ws.card_b[child[j].first];
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <random>
+#include "Population.h"
+#include "Random.h"
+
+// 保持优先关系的交叉算子：两个父代都是合法执行序（拓扑序）时，子代也是合法执行序，无需再做拓扑解码。
+// 均直接在稠密数组上 O(N) 完成，不使用哈希表；节点 id 需连续（0..N-1）。父代为基因池行的只读视图。
+// perm_b 把父代 B 的卡号映射到 A 的卡号体系（见 AlignCards），为空表示不映射
+
+// 工作区：复用标记与掩码数组，避免每次分配
+struct CrossoverWorkspace {
+    std::vector<char> taken;
+    std::vector<char> from_a;
+    std::vector<int> card_b;
+};
+
+// PPX（precedence preserving crossover）：逐位等概率选择父代，取该父代序列中下一个尚未放入子代的节点，
+// 卡号随节点来自的父代
+void PrecedencePreservingCrossover(
+    const RowView& A,
+    const RowView& B,
+    const std::vector<int>& perm_b,
+    CounterRng& rng,
+    CrossoverWorkspace& ws,
+    std::vector<std::pair<int,int>>& child);
+
+// 两点顺序交叉：随机切点 p1 <= p2，子代位置 [0,p1) 与 [p2,N) 取自 A、[p1,p2) 取自 B，
+// 每次取对应父代中下一个尚未放入的节点（即掩码为 A..AB..BA..A 的 PPX）
+void TwoPointOrderCrossover(
+    const RowView& A,
+    const RowView& B,
+    const std::vector<int>& perm_b,
+    CounterRng& rng,
+    CrossoverWorkspace& ws,
+    std::vector<std::pair<int,int>>& child);
+
+// 卡均匀交叉：执行序沿用 A，每个节点的卡号等概率取 A 或 B 中该节点的卡号
+void CardUniformCrossover(
+    const RowView& A,
+    const RowView& B,
+    const std::vector<int>& perm_b,
+    CounterRng& rng,
+    CrossoverWorkspace& ws,
+    std::vector<std::pair<int,int>>& child);
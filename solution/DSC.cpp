@@ -0,0 +1,183 @@
+#include "DSC.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <random>
+#include "GAInit.h"
+#include "Simulator.h"
+
+namespace {
+
+// LPT：簇按 exec 总和降序，依次放到当前负载最小的卡
+std::vector<int> MapByLoad(const std::vector<long long>& load, int card_num) {
+    std::vector<int> by_load(load.size());
+    std::iota(by_load.begin(), by_load.end(), 0);
+    std::stable_sort(by_load.begin(), by_load.end(), [&](int a, int b){ return load[a] > load[b]; });
+    std::vector<long long> card_load(card_num, 0);
+    std::vector<int> card_of(load.size(), 0);
+    for (int c : by_load) {
+        int card = static_cast<int>(std::min_element(card_load.begin(), card_load.end()) - card_load.begin());
+        card_of[c] = card;
+        card_load[card] += load[c];
+    }
+    return card_of;
+}
+
+// 按簇的首个开始时间依次装卡：优先放到在簇开始前已空闲的卡中最晚空闲的一张（最紧贴），
+// 否则放到最早空闲的卡；卡被占用的时长取 busy[c]（簇负载或簇时间跨度）
+std::vector<int> MapByTime(const std::vector<long long>& first, const std::vector<long long>& busy, int card_num) {
+    std::vector<int> by_start(first.size());
+    std::iota(by_start.begin(), by_start.end(), 0);
+    std::stable_sort(by_start.begin(), by_start.end(), [&](int a, int b){ return first[a] < first[b]; });
+    std::vector<long long> card_free(card_num, 0);
+    std::vector<int> card_of(first.size(), 0);
+    for (int c : by_start) {
+        int best = -1;
+        for (int k = 0; k < card_num; ++k) {
+            if (card_free[k] <= first[c] && (best < 0 || card_free[k] > card_free[best])) best = k;
+        }
+        if (best < 0) best = static_cast<int>(std::min_element(card_free.begin(), card_free.end()) - card_free.begin());
+        card_of[c] = best;
+        card_free[best] = std::max(card_free[best], first[c]) + busy[c];
+    }
+    return card_of;
+}
+
+} // namespace
+
+DSCClustering DominantSequenceClustering(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node)
+{
+    DSCClustering res;
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+    if (m == 0) return res;
+
+    // 拓扑序与含通信的 blevel
+    std::unordered_map<int,int> indeg = indeg0;
+    std::vector<int> topo;
+    topo.reserve(indeg.size());
+    for (const auto& kv : indeg) if (kv.second == 0) topo.push_back(kv.first);
+    for (size_t i = 0; i < topo.size(); ++i) {
+        auto it = adj.find(topo[i]);
+        if (it == adj.end()) continue;
+        for (int v : it->second) if (--indeg[v] == 0) topo.push_back(v);
+    }
+    std::vector<long long> blevel(m, 0);
+    for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+        int v = *it;
+        long long tail = 0;
+        auto jt = adj.find(v);
+        if (jt != adj.end()) {
+            for (int s : jt->second) tail = std::max(tail, nodes[v]->transfer_time() + blevel[s]);
+        }
+        blevel[v] = nodes[v]->exec_time() + tail;
+    }
+
+    res.cluster.assign(m, -1);
+    res.start.assign(m, 0);
+    std::vector<long long> finish(m, 0);
+    std::vector<long long> cluster_ready; // 簇内最后一个节点的完成时间
+    std::vector<int> cluster_cand;
+
+    // 自由节点（前驱均已处理）按 tlevel + blevel 降序出队
+    using Key = std::pair<long long,int>;
+    std::priority_queue<Key> free_list;
+    indeg = indeg0;
+    auto tlevel = [&](int v) {
+        long long t = 0;
+        for (const Node* p : nodes[v]->inputs()) {
+            if (p) t = std::max(t, finish[p->id()] + p->transfer_time());
+        }
+        return t;
+    };
+    for (const auto& kv : indeg) if (kv.second == 0) free_list.push({blevel[kv.first], kv.first});
+
+    while (!free_list.empty()) {
+        int v = free_list.top().second;
+        free_list.pop();
+        const Node* node = nodes[v];
+        // 自成一簇时的开始时间
+        long long best_start = tlevel(v);
+        int best_cluster = -1;
+        cluster_cand.clear();
+        for (const Node* p : node->inputs()) if (p) cluster_cand.push_back(res.cluster[p->id()]);
+        std::sort(cluster_cand.begin(), cluster_cand.end());
+        cluster_cand.erase(std::unique(cluster_cand.begin(), cluster_cand.end()), cluster_cand.end());
+        for (int c : cluster_cand) {
+            // 追加到簇 c 末尾：簇内输入不计通信
+            long long s = cluster_ready[c];
+            for (const Node* p : node->inputs()) {
+                if (!p) continue;
+                int pid = static_cast<int>(p->id());
+                s = std::max(s, finish[pid] + (res.cluster[pid] == c ? 0 : p->transfer_time()));
+            }
+            if (s < best_start) { best_start = s; best_cluster = c; }
+        }
+        if (best_cluster < 0) {
+            best_cluster = static_cast<int>(cluster_ready.size());
+            cluster_ready.push_back(0);
+        }
+        res.cluster[v] = best_cluster;
+        res.start[v] = best_start;
+        finish[v] = best_start + node->exec_time();
+        cluster_ready[best_cluster] = finish[v];
+        res.makespan = std::max(res.makespan, finish[v]);
+
+        auto it = adj.find(v);
+        if (it == adj.end()) continue;
+        for (int s : it->second) {
+            if (--indeg[s] == 0) free_list.push({tlevel(s) + blevel[s], s});
+        }
+    }
+    res.clusters = static_cast<int>(cluster_ready.size());
+    return res;
+}
+
+std::vector<std::pair<int,int>> BuildDSCIndividual(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num)
+{
+    if (card_num <= 0) return {};
+    DSCClustering dsc = DominantSequenceClustering(indeg0, adj, id2node);
+    if (dsc.clusters == 0) return {};
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+
+    // 簇负载与时间跨度 [首个节点开始, 最后节点完成)
+    std::vector<long long> load(dsc.clusters, 0), first(dsc.clusters, -1), span(dsc.clusters, 0);
+    for (size_t v = 0; v < dsc.cluster.size(); ++v) {
+        int c = dsc.cluster[v];
+        if (c < 0) continue;
+        load[c] += nodes[v]->exec_time();
+        if (first[c] < 0 || dsc.start[v] < first[c]) first[c] = dsc.start[v];
+    }
+    for (size_t v = 0; v < dsc.cluster.size(); ++v) {
+        int c = dsc.cluster[v];
+        if (c >= 0) span[c] = std::max(span[c], dsc.start[v] + nodes[v]->exec_time() - first[c]);
+    }
+
+    // 三种簇到卡的映射各生成一个执行序（顺序按 DSC 开始时间），取模拟 makespan 最小者
+    std::unordered_map<int,double> prio;
+    prio.reserve(indeg0.size());
+    for (const auto& kv : indeg0) prio[kv.first] = static_cast<double>(dsc.start[kv.first]);
+    CounterRng rng(0); // 所有节点都有继承卡，不会用到随机数
+    std::vector<std::pair<int,int>> best;
+    long long best_fit = -1;
+    for (const auto& card_of : {MapByLoad(load, card_num),
+                                MapByTime(first, load, card_num),
+                                MapByTime(first, span, card_num)}) {
+        std::unordered_map<int,int> cards;
+        cards.reserve(indeg0.size());
+        for (const auto& kv : indeg0) cards[kv.first] = card_of[dsc.cluster[kv.first]];
+        auto order = TopoByPriority(indeg0, adj, card_num, rng, prio, &cards);
+        if (order.empty()) continue;
+        long long fit = SimulateOrder(order, nodes, card_num);
+        if (best_fit < 0 || fit < best_fit) { best_fit = fit; best.swap(order); }
+    }
+    return best;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// DSC（dominant sequence clustering）结果：cluster[id] 为簇编号，start[id] 为无限簇假设下的开始时间
+struct DSCClustering {
+    std::vector<int> cluster;
+    std::vector<long long> start;
+    int clusters = 0;
+    long long makespan = 0;  // 无限簇（每簇独占一卡）时的并行时间
+};
+
+// DSC 聚类：按 tlevel + blevel 最大的自由节点依次处理（优先队列），
+// 尝试把节点追加到某个前驱所在簇的末尾以置零对应的 transfer 边，能降低其开始时间则合并，否则自成一簇
+DSCClustering DominantSequenceClustering(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node);
+
+// DSC 种子：簇映射到 card_num 张卡（LPT 负载均衡，或按簇开始时间装入最早空闲的卡），
+// 执行序按 DSC 开始时间，返回几种映射中模拟 makespan 最小的一个
+std::vector<std::pair<int,int>> BuildDSCIndividual(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num);
@@ -0,0 +1,113 @@
+#include "Deadline.h"
+
+#include <algorithm>
+#include <deque>
+
+const char* StopReasonName(StopReason reason)
+{
+    switch (reason) {
+    case StopReason::kDeadline: return "deadline";
+    case StopReason::kStagnation: return "stagnation";
+    case StopReason::kLowerBound: return "lower_bound";
+    case StopReason::kWorkLimit: return "work_limit";
+    default: return "none";
+    }
+}
+
+long long MakespanLowerBound(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num)
+{
+    if (card_num <= 0) return 0;
+    long long total = 0;
+    long long longest = 0;
+    std::unordered_map<int,int> indeg = indeg0;
+    std::unordered_map<int,long long> finish;
+    std::deque<int> q;
+    for (const auto& kv : indeg) if (kv.second == 0) q.push_back(kv.first);
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop_front();
+        long long exec = id2node.at(u)->exec_time();
+        total += exec;
+        long long f = finish[u] + exec;
+        longest = std::max(longest, f);
+        auto it = adj.find(u);
+        if (it == adj.end()) continue;
+        for (int v : it->second) {
+            finish[v] = std::max(finish[v], f);
+            if (--indeg[v] == 0) q.push_back(v);
+        }
+    }
+    return std::max(longest, (total + card_num - 1) / card_num);
+}
+
+AnytimeController::AnytimeController(Clock::time_point deadline, long long lower_bound, double gap_tolerance,
+                                     int stall_rounds, double stall_window_share, double stall_tolerance, double safety)
+    : start_(Clock::now()), deadline_(deadline), last_(start_), lower_bound_(lower_bound),
+      gap_tolerance_(gap_tolerance), stall_rounds_(stall_rounds), stall_window_share_(stall_window_share),
+      stall_tolerance_(stall_tolerance), safety_(safety)
+{
+}
+
+void AnytimeController::FixedWork(long long max_rounds, long long max_work)
+{
+    fixed_work_ = true;
+    max_rounds_ = max_rounds;
+    max_work_ = max_work;
+}
+
+bool AnytimeController::Affords(double predicted_ms) const
+{
+    if (fixed_work_) return true;
+    double remain_ms = std::chrono::duration<double, std::milli>(deadline_ - Clock::now()).count();
+    return predicted_ms * safety_ <= remain_ms;
+}
+
+bool AnytimeController::Continue(long long best, long long work)
+{
+    auto now = fixed_work_ ? start_ : Clock::now();
+    if (rounds_ > 0 && !fixed_work_) {
+        last_ms_ = std::chrono::duration<double, std::milli>(now - last_).count();
+        ema_ms_ = (rounds_ == 1) ? last_ms_ : 0.7 * ema_ms_ + 0.3 * last_ms_;
+    }
+    last_ = now;
+    double t_ms = fixed_work_ ? static_cast<double>(rounds_) : std::chrono::duration<double, std::milli>(now - start_).count();
+    if (best_ < 0 || best < best_) {
+        best_ = best;
+        last_improve_ = rounds_;
+    }
+    history_.emplace_back(t_ms, best_);
+
+    if (lower_bound_ > 0 && best_ <= static_cast<long long>(lower_bound_ * (1.0 + gap_tolerance_))) {
+        reason_ = StopReason::kLowerBound;
+        return false;
+    }
+    if (fixed_work_) {
+        if ((max_rounds_ > 0 && rounds_ >= max_rounds_) || (max_work_ > 0 && work >= max_work_)) {
+            reason_ = StopReason::kWorkLimit;
+            return false;
+        }
+    } else if (!Affords(std::max(last_ms_, ema_ms_))) {
+        reason_ = StopReason::kDeadline;
+        return false;
+    }
+    if (stall_rounds_ > 0 && rounds_ - last_improve_ >= stall_rounds_) {
+        // 窗口起点的 best：history_ 按时间递增，取第一条不早于窗口起点的记录
+        double window_ms = std::max(t_ms * stall_window_share_, fixed_work_ ? 1.0 : 1e-3);
+        auto it = std::lower_bound(history_.begin(), history_.end(), t_ms - window_ms,
+                                   [](const std::pair<double,long long>& h, double t) { return h.first < t; });
+        double rate = static_cast<double>(it->second - best_) / window_ms;
+        double remain_ms = fixed_work_
+            ? static_cast<double>(max_rounds_ > 0 ? max_rounds_ - rounds_ : rounds_)
+            : std::chrono::duration<double, std::milli>(deadline_ - now).count();
+        if (rate * remain_ms < stall_tolerance_ * best_) {
+            reason_ = StopReason::kStagnation;
+            return false;
+        }
+    }
+    ++rounds_;
+    return true;
+}
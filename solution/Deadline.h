@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+#include "node.h"
+
+// 停止原因
+enum class StopReason { kNone, kDeadline, kStagnation, kLowerBound, kWorkLimit };
+
+const char* StopReasonName(StopReason reason);
+
+// makespan 下界：max(总 exec / 卡数 向上取整, 不计通信的最长 exec 路径)
+long long MakespanLowerBound(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num);
+
+// 随时（anytime）截止控制：迭代式搜索每轮开始前调用 Continue。
+// 下一轮开销按最近一轮与指数平均耗时的较大者乘 safety 预测，放不下则停止，保证不越过截止时间；
+// best 与下界的相对差距不超过 gap_tolerance 时停止；
+// 连续 stall_rounds 轮未改进时，按最近 stall_window_share 比例已用时间内的改进速率外推到剩余时间，
+// 预计收益低于 best 的 stall_tolerance 则判为停滞。
+// 固定工作量模式下不读时钟：时间轴换成轮数，轮数达到 max_rounds 或工作量（如评估次数）达到 max_work 时停止
+class AnytimeController {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    AnytimeController(Clock::time_point deadline, long long lower_bound, double gap_tolerance,
+                      int stall_rounds, double stall_window_share, double stall_tolerance, double safety);
+
+    void FixedWork(long long max_rounds, long long max_work);
+    // 首轮开销的先验估计（毫秒），首轮结束后被实测值取代
+    void Prime(double round_ms) { ema_ms_ = round_ms; }
+    bool Continue(long long best, long long work = 0);
+    // 预计耗时 predicted_ms 的一步能否在截止前完成
+    bool Affords(double predicted_ms) const;
+
+    StopReason reason() const { return reason_; }
+    long long rounds() const { return rounds_; }
+    double round_ms() const { return ema_ms_; }
+
+private:
+    Clock::time_point start_;
+    Clock::time_point deadline_;
+    Clock::time_point last_;
+    long long lower_bound_;
+    double gap_tolerance_;
+    int stall_rounds_;
+    double stall_window_share_;
+    double stall_tolerance_;
+    double safety_;
+    bool fixed_work_ = false;
+    long long max_rounds_ = 0;
+    long long max_work_ = 0;
+    std::vector<std::pair<double,long long>> history_; // (距开始毫秒, 当时 best)，best 单调不增
+    long long best_ = -1;
+    long long rounds_ = 0;
+    long long last_improve_ = 0;
+    double last_ms_ = 0.0;
+    double ema_ms_ = 0.0;
+    StopReason reason_ = StopReason::kNone;
+};
@@ -0,0 +1,39 @@
+#include "FitnessCache.h"
+
+uint64_t ScheduleHash(const std::vector<std::pair<int,int>>& order)
+{
+    uint64_t h = 0;
+    for (size_t i = 0; i < order.size(); ++i) h ^= PositionKey(static_cast<int>(i), order[i].first, order[i].second);
+    return h;
+}
+
+FitnessCache::FitnessCache(size_t capacity)
+    : capacity_(capacity)
+{
+    map_.reserve(capacity);
+    ring_.reserve(capacity);
+}
+
+bool FitnessCache::Find(uint64_t key, long long* fit)
+{
+    ++lookups_;
+    auto it = map_.find(key);
+    if (it == map_.end()) return false;
+    ++hits_;
+    *fit = it->second;
+    return true;
+}
+
+void FitnessCache::Insert(uint64_t key, long long fit)
+{
+    if (capacity_ == 0) return;
+    auto res = map_.emplace(key, fit);
+    if (!res.second) return;
+    if (ring_.size() < capacity_) {
+        ring_.push_back(key);
+        return;
+    }
+    map_.erase(ring_[next_]);
+    ring_[next_] = key;
+    next_ = (next_ + 1) % capacity_;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+// splitmix64 终混
+inline uint64_t HashMix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// 位置键：(位置, 节点, 卡) 由 splitmix64 逐分量混合，各分量不共享比特位，任意节点数与卡号都不会因拼接而重叠。
+// 调度哈希为各位置键的异或，查缓存时对整条执行序重算（O(N)）
+inline uint64_t PositionKey(int pos, int node, int card)
+{
+    return HashMix(HashMix(HashMix(static_cast<uint64_t>(pos)) ^ static_cast<uint64_t>(node))
+                      ^ static_cast<uint64_t>(card));
+}
+
+uint64_t ScheduleHash(const std::vector<std::pair<int,int>>& order);
+
+// 有界适应度缓存：哈希 -> makespan，满后按插入顺序（FIFO）淘汰；不做碰撞校验（64 位哈希）
+class FitnessCache {
+public:
+    explicit FitnessCache(size_t capacity);
+
+    // 命中时写入 *fit 并返回 true
+    bool Find(uint64_t key, long long* fit);
+    void Insert(uint64_t key, long long fit);
+
+    size_t size() const { return map_.size(); }
+    long long lookups() const { return lookups_; }
+    long long hits() const { return hits_; }
+
+private:
+    size_t capacity_;
+    std::unordered_map<uint64_t, long long> map_;
+    std::vector<uint64_t> ring_;  // 插入顺序，用于淘汰
+    size_t next_ = 0;
+    long long lookups_ = 0;
+    long long hits_ = 0;
+};
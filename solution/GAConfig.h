@@ -3,12 +3,117 @@
 
 #include <string>
 
+// 交叉算子：优先级平均 + EFT 解码，或稠密数组上 O(N) 的保序交叉；kMix 每次从前四种中等概率选一种
+enum class CrossoverOp {
+    kPriorityEFT,
+    kPPX,
+    kTwoPoint,
+    kCardUniform,
+    kMix
+};
+
 struct GAConfig {
     int pop_size = 5;
-    int generations = 120;
+    int generations = 120; // 仅固定工作量模式使用
     double mutation_rate = 0.5;
     int tournament_k = 2;
+
+    // 列表调度优先级权重：按图内最大值归一化的特征加权和，越大越先调度（见 PriorityRule.h），
+    // 用于 learned 种子与带噪种子；可由 eo_train_priority 在语料上拟合后经配置文件加载。
+    // 默认只取 upward-rank（与 HEFT 同序）；一份拟合结果见 tools/priority_weights.cfg
+    double prio_w_exec = 0.0;
+    double prio_w_transfer = 0.0;
+    double prio_w_up_rank = 1.0;
+    double prio_w_down_rank = 0.0;
+    double prio_w_out_degree = 0.0;
+    double prio_w_slack = 0.0;
     int seed = -1; // <0 表示使用时间种子
+    int rng_stream = 0; // 同一种子下的随机数流号，并行子问题（分量分组）各用一条
+
+    // 固定工作量模式：不看墙钟，GA 在 generations 代或 max_evaluations 次评估（0 表示不限）后结束，
+    // LNS 最多求解 lns_fixed_windows 个窗口；配合固定 seed，结果与线程数、机器速度无关，可逐位复现
+    bool fixed_work = false;
+    long long max_evaluations = 0;
+    long long lns_fixed_windows = 200;
+    bool verbose = true; // 各阶段统计输出到 stderr
+    bool auto_select = true; // 按图特征选择求解策略（见 Strategy.h），显式配置仍覆盖所选值
+    bool greedy_seed = true; // 贪心 EFT 种子（逐步在全部就绪节点 × 全部卡上取最早完成）
+    bool partition_seed = false; // 通信最小化划分种子：各例上均为最差种子且构造较慢，默认关闭
+
+    // 截止控制：deadline_ms > 0 时覆盖按节点数缩放的默认预算（50000 点≈60 秒）。
+    // GA 在 best 与下界差距不超过 deadline_gap 时结束；连续 stall_generations 代未改进、
+    // 且按最近 stall_window_share 比例时间内的改进速率外推，剩余时间的预计收益低于 best 的 stall_tolerance 时结束；
+    // 下一代预计耗时乘 deadline_safety 后放不下时也结束；deadline_reserve_share 为预留给结果展开与清理的比例
+    long long deadline_ms = 0;
+    double deadline_reserve_share = 0.01;
+    double deadline_gap = 0.001;
+    double deadline_safety = 1.2;
+    int stall_generations = 30;
+    double stall_window_share = 0.5;
+    double stall_tolerance = 0.001;
+
+    // 线性链收缩：单输入/单消费者链合并为超节点后再搜索
+    bool chain_contraction = true;
+    double chain_max_load_share = 0.1;  // 超节点 exec 上限占单卡平均负载的比例
+
+    // 弱连通分量分解：最大分量不超过总节点数 comp_max_share 时，分组独立并行求解后合并
+    bool comp_enabled = true;
+    double comp_max_share = 0.9;
+    int comp_max_groups = 8;
+    double comp_time_share = 0.7;       // 子问题求解占总时间预算的比例
+
+    // 多级模式：节点数超过 ml_min_nodes 时粗化到 ml_coarsest_nodes 以下再求解并逐层投影精修
+    bool ml_enabled = true;
+    int ml_min_nodes = 20000;
+    int ml_coarsest_nodes = 2000;
+    double ml_coarse_share = 0.5;       // 最粗层求解占总时间预算的比例
+
+    // 卡对称规范化：个体按首次使用顺序重编卡号，交叉前把第二个父代的卡号对齐到第一个
+    bool canonical_cards = true;
+
+    // 适应度缓存容量（按调度哈希，FIFO 淘汰）：0 表示关闭
+    int fitness_cache_size = 1 << 16;
+
+    CrossoverOp crossover_op = CrossoverOp::kPriorityEFT;
+
+    // 自适应算子选择：开启时交叉算子与变异算子（含不变异、卡精修）由 UCB 老虎机按 改进量/毫秒 选择，
+    // crossover_op 与 mutation_rate 不再生效；bandit_decay 为回报的指数衰减系数
+    bool bandit_enabled = true;
+    double bandit_decay = 0.9;
+    double bandit_explore = 0.5;
+
+    // 代理预筛选：每个子代空位生成 surrogate_pool 个交叉候选，只解码代理评分最优者；<=1 表示关闭。
+    // 每 surrogate_audit_interval 代全量评估一次候选，比较代理分与解码后（变异前）真实 makespan 的秩相关，
+    // 核对满 surrogate_min_audits 次后平均秩相关 <= 0（代理排序无益或反向）时本次求解余下各代关闭筛选。
+    // 默认关闭：在各例上未见稳定收益，需要时用 EO_SURROGATE_POOL 打开
+    int surrogate_pool = 1;
+    int surrogate_audit_interval = 10;
+    int surrogate_min_audits = 3;
+
+    // 束搜索解码器（额外种子）：beam_width 为 0 时关闭
+    int beam_width = 4;
+    int beam_expand = 3;              // 每个部分调度扩展的就绪节点数
+    double beam_time_share = 0.4;     // 最多占用剩余 GA 时间的比例，超时放弃该种子
+
+    // 关键链定向变异：变异时按该比例走关键链算子，其余走全局噪声重建
+    double cp_mutation_share = 0.7;
+    double cp_link_ratio = 0.3;       // 每次修改的关键环节比例
+
+    // 前向-后向（justification）改进：作用于每代精英
+    bool fbj_enabled = true;
+    int fbj_max_iters = 4;            // 单次调用最多迭代轮数
+
+    // 路径重连：每 pr_interval 代在最优两精英之间双向重连一次
+    bool pr_enabled = true;
+    int pr_interval = 5;
+    int pr_max_evals = 32;            // 单次重连最多评估的中间解数
+
+    // 大邻域搜索（LNS）：GA 结束后在时间预算内对最优解做窗口精确重排
+    bool lns_enabled = true;
+    double lns_time_share = 0.3;      // 占总时间预算的比例
+    int lns_window = 6;               // 窗口长度（连续位置数）
+    long long lns_node_limit = 20000; // 单窗口分支定界展开节点上限
+    long long lns_leaf_limit = 64;    // 单窗口后缀模拟（叶子评估）次数上限
 };
 
 #endif // NPU_GACONFIG_H
\ No newline at end of file
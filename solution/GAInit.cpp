@@ -6,12 +6,19 @@
 #include <queue>
 #include <unordered_set>
 #include <numeric>
+#include <chrono>
+#include "DSC.h"
+#include "Insertion.h"
+#include "Partition.h"
+#include "PEFT.h"
+#include "Simulator.h"
+#include "Template.h"
 
 std::vector<std::pair<int,int>> TopoByPriority(
         const std::unordered_map<int,int>& indeg0,
         const std::unordered_map<int,std::vector<int>>& adj,
         int card_num,
-        std::mt19937& rng,
+        CounterRng& rng,
         const std::unordered_map<int,double>& priority,
         const std::unordered_map<int,int>* inherit_cards)
 {
@@ -71,7 +78,7 @@ std::vector<std::pair<int,int>> TopoByPriorityWithEFT(
         const std::unordered_map<int,std::vector<int>>& adj,
         const std::unordered_map<int, const Node*>& id2node,
         int card_num,
-        std::mt19937& rng,
+        CounterRng& rng,
         const std::unordered_map<int,double>& priority,
         const std::unordered_map<int,int>* inherit_cards)
 {
@@ -204,7 +211,7 @@ std::vector<std::pair<int,int>> TopoByPriorityWithEFT(
 }
 
 // 基于当前图计算 HEFT upward-rank
-static std::unordered_map<int,double> ComputeUpwardRank(
+std::unordered_map<int,double> ComputeUpwardRank(
         const std::unordered_map<int,int>& indeg0,
         const std::unordered_map<int,std::vector<int>>& adj,
         const std::unordered_map<int, const Node*>& id2node)
@@ -256,7 +263,7 @@ static std::vector<std::pair<int,int>> BuildGreedyIndividual(
         const std::unordered_map<int,std::vector<int>>& adj,
         const std::unordered_map<int, const Node*>& id2node,
         int card_num,
-        std::mt19937& rng,
+        CounterRng& rng,
         bool randomized)
 {
     if (card_num <= 0) return {};
@@ -403,74 +410,124 @@ std::vector<std::vector<std::pair<int,int>>> InitializePopulation(
         const std::unordered_map<int, const Node*>& id2node,
         int card_num,
         int pop_size,
-        std::mt19937& rng)
+        bool greedy_seed,
+        bool partition_seed,
+        const PriorityWeights& prio_weights,
+        std::chrono::high_resolution_clock::time_point deadline,
+        CounterRng& rng,
+        std::vector<SeedReport>* report)
 {
     std::vector<std::vector<std::pair<int,int>>> population;
     population.reserve(pop_size);
 
-    // 先加入一个贪心解，作为种群的强种子
-    auto greedy = BuildGreedyIndividual(indeg0, adj, id2node, card_num, rng, false);
-    if (!greedy.empty()) population.push_back(std::move(greedy));
-
-    // 新增：长运行优先的贪心（按 exec_time 降序的优先级拓扑），卡分配用 EFT
-    {
-        std::unordered_map<int,double> long_prio;
-        long_prio.reserve(node_ids.size());
-        for (int nid : node_ids) {
-            auto it = id2node.find(nid);
-            if (it != id2node.end() && it->second) {
-                long_prio[nid] = -static_cast<double>(it->second->exec_time());
-            } else {
-                long_prio[nid] = 0.0;
-            }
+    // 记录种子的构造耗时与 makespan，便于比较各启发式
+    std::vector<const Node*> dense;
+    if (report) dense = DenseNodes(id2node);
+    // 长任务优先级（按 exec_time 降序），兜底种子与 long_first 共用
+    std::unordered_map<int,double> long_prio;
+    long_prio.reserve(node_ids.size());
+    for (int nid : node_ids) {
+        auto it = id2node.find(nid);
+        if (it != id2node.end() && it->second) {
+            long_prio[nid] = -static_cast<double>(it->second->exec_time());
+        } else {
+            long_prio[nid] = 0.0;
         }
-        auto long_first = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, long_prio, nullptr);
-        if (!long_first.empty()) population.push_back(std::move(long_first));
+    }
+    // 兜底种子：同一优先级的非 EFT 列表调度（不逐卡评估），只在截止时间前放不下任何其他种子时使用；
+    // 用独立随机数流，不影响其余种子。其耗时 × 卡数/2（实测 EFT 选卡的倍数）作为尚未测得耗时时 EFT 类种子的预估
+    auto t_seed = std::chrono::high_resolution_clock::now();
+    CounterRng fallback_rng = rng.Fork(0);
+    auto fallback = TopoByPriority(indeg0, adj, card_num, fallback_rng, long_prio, nullptr);
+    if (fallback.empty()) return {}; // 有环，无法调度
+    double max_seed_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_seed).count()
+                         * std::max(2, card_num / 2);
+    auto add_seed = [&](const char* name, std::vector<std::pair<int,int>>&& indiv) {
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_seed).count();
+        max_seed_ms = std::max(max_seed_ms, ms);
+        if (report) report->push_back({name, indiv.empty() ? -1 : SimulateOrder(indiv, dense, card_num), ms});
+        if (!indiv.empty()) population.push_back(std::move(indiv));
+        t_seed = std::chrono::high_resolution_clock::now();
+    };
+    // 还能否在截止时间前再构造一个种子（按已构造种子的最长耗时预测）
+    auto affords = [&]() {
+        return std::chrono::high_resolution_clock::now()
+                   + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                         std::chrono::duration<double, std::milli>(max_seed_ms)) <= deadline;
+    };
+
+    // 先加入一个贪心解，作为种群的强种子
+    t_seed = std::chrono::high_resolution_clock::now();
+    if (greedy_seed && affords()) add_seed("greedy_eft", BuildGreedyIndividual(indeg0, adj, id2node, card_num, rng, false));
+
+    // 新增：长运行优先的贪心，卡分配用 EFT
+    if (affords()) {
+        add_seed("long_first", TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, long_prio, nullptr));
     }
 
     // 新增：HEFT upward-rank 初始个体（按关键路径优先），卡分配用 EFT
-    {
+    if (affords()) {
         auto rank_u = ComputeUpwardRank(indeg0, adj, id2node);
         std::unordered_map<int,double> heft_prio;
         heft_prio.reserve(rank_u.size());
         for (const auto& kv : rank_u) heft_prio[kv.first] = -kv.second;
-        auto heft_indiv = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, heft_prio, nullptr);
-        if (!heft_indiv.empty()) population.push_back(std::move(heft_indiv));
+        add_seed("heft", TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, heft_prio, nullptr));
+        // 插入式 HEFT：同一 rank 顺序，但允许填入卡上的空闲区间
+        if (affords()) add_seed("heft_insert", BuildInsertionIndividual(indeg0, adj, id2node, rank_u, card_num, nullptr));
+        // 通信最小化的均衡划分：分区直接作为卡号，顺序仍按 upward-rank
+        if (partition_seed && affords()) {
+            std::vector<int> part = KWayPartition(DenseNodes(id2node), card_num, false, 0.03, 4, nullptr);
+            std::unordered_map<int,int> part_cards;
+            part_cards.reserve(node_ids.size());
+            for (int nid : node_ids) part_cards[nid] = part[nid];
+            add_seed("partition", TopoByPriority(indeg0, adj, card_num, rng, heft_prio, &part_cards));
+        }
     }
 
-    // 其余用启发式 + 随机噪声生成，卡分配改用非EFT（更快），再小比例精修
-    std::uniform_real_distribution<double> noise(0.0, 0.1);
-    for (int i = static_cast<int>(population.size()); i < pop_size; ++i) {
-        std::unordered_map<int,double> prio;
-        prio.reserve(node_ids.size());
-        for (int nid : node_ids) {
-            auto it = id2node.find(nid);
-            if (it != id2node.end() && it->second) {
-                const Node* n = it->second;
-                double base = n->exec_time() + 0.5 * n->transfer_time();
-                prio[nid] = -base + noise(rng);
-            } else {
-                prio[nid] = noise(rng);
-            }
-        }
+    // 参数化优先级：特征加权（权重可离线训练），EFT 选卡；优先级在首次用到时计算
+    std::unordered_map<int,double> base_prio;
+    auto learned_prio = [&]() -> const std::unordered_map<int,double>& {
+        if (base_prio.empty()) base_prio = WeightedPriority(ComputePriorityFeatures(indeg0, adj, id2node), prio_weights);
+        return base_prio;
+    };
+    // 权重只含 upward-rank 时与 HEFT 种子同序，不重复解码
+    bool heft_weights = prio_weights[kFeatUpRank] > 0;
+    for (int f = 0; f < kPriorityFeatureNum; ++f) {
+        if (f != kFeatUpRank && prio_weights[f] != 0) heft_weights = false;
+    }
+    if (!heft_weights && affords()) add_seed("learned", TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, learned_prio(), nullptr));
+
+    // PEFT：乐观代价表前瞻后继放置代价，同时用于排序与选卡
+    if (affords()) add_seed("peft", BuildPEFTIndividual(indeg0, adj, id2node, card_num));
+
+    // DSC：置零主导序列上的通信边聚类，再把簇映射到卡
+    if (affords()) add_seed("dsc", BuildDSCIndividual(indeg0, adj, id2node, card_num));
+
+    // 重复子图模板：同构的重复实例只调度一个，开始时间与卡号盖印到其余实例
+    if (affords()) add_seed("template", BuildTemplateIndividual(indeg0, adj, id2node, card_num));
+
+    // 其余用参数化优先级 + 随机噪声生成，卡分配改用非EFT（更快），再小比例精修
+    std::uniform_real_distribution<double> noise(0.0, 0.05);
+    for (int i = static_cast<int>(population.size()); i < pop_size && affords(); ++i) {
+        std::unordered_map<int,double> prio = learned_prio();
+        for (auto& kv : prio) kv.second += noise(rng);
         auto indiv = TopoByPriority(indeg0, adj, card_num, rng, prio, nullptr);
         if (indiv.empty()) return {}; // 有环，无法调度
         indiv = RefineCardsByEFT(indiv, id2node, card_num, 0.3, rng); // 只对部分节点做 EFT 精修
-        population.push_back(std::move(indiv));
+        add_seed("noisy", std::move(indiv));
     }
+    if (population.empty()) add_seed("fallback", std::move(fallback));
     return population;
 }
 
-std::vector<std::pair<int,int>> RefineCardsByEFT(
+// 对 to_refine 中的位置按 EFT 重选卡，其余位置保持原卡
+static std::vector<std::pair<int,int>> RefineCardsAtPositions(
     const std::vector<std::pair<int,int>>& order,
     const std::unordered_map<int, const Node*>& id2node,
     int card_num,
-    double refine_ratio,
-    std::mt19937& rng) {
-    if (order.empty() || card_num <= 1 || refine_ratio <= 0.0) return order;
+    const std::unordered_set<int>& to_refine) {
     std::vector<std::pair<int,int>> result = order;
     int n = static_cast<int>(order.size());
-    int refine_count = std::max(1, static_cast<int>(n * refine_ratio));
 
     // 记录每张卡的ready时间、每个节点的完成时间和数据所在卡
     int max_id = 0;
@@ -480,13 +537,6 @@ std::vector<std::pair<int,int>> RefineCardsByEFT(
     std::vector<long long> finish_time(max_id + 1, -1);
     std::vector<int> data_card(max_id + 1, -1);
 
-    // 随机选择需要重分配卡的索引
-    std::vector<int> indices(n);
-    std::iota(indices.begin(), indices.end(), 0);
-    std::shuffle(indices.begin(), indices.end(), rng);
-    indices.resize(refine_count);
-    std::unordered_set<int> to_refine(indices.begin(), indices.end());
-
     for (int i = 0; i < n; ++i) {
         int nid = order[i].first;
         int ori_card = order[i].second;
@@ -580,4 +630,33 @@ std::vector<std::pair<int,int>> RefineCardsByEFT(
         data_card[nid] = chosen_card;
     }
     return result;
-}
\ No newline at end of file
+}
+
+std::vector<std::pair<int,int>> RefineCardsByEFT(
+    const std::vector<std::pair<int,int>>& order,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    double refine_ratio,
+    CounterRng& rng) {
+    if (order.empty() || card_num <= 1 || refine_ratio <= 0.0) return order;
+    int n = static_cast<int>(order.size());
+    int refine_count = std::max(1, static_cast<int>(n * refine_ratio));
+
+    // 随机选择需要重分配卡的索引
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::shuffle(indices.begin(), indices.end(), rng);
+    indices.resize(refine_count);
+    std::unordered_set<int> to_refine(indices.begin(), indices.end());
+    return RefineCardsAtPositions(order, id2node, card_num, to_refine);
+}
+
+std::vector<std::pair<int,int>> RefineCardsAt(
+    const std::vector<std::pair<int,int>>& order,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    const std::vector<int>& positions) {
+    if (order.empty() || card_num <= 1 || positions.empty()) return order;
+    std::unordered_set<int> to_refine(positions.begin(), positions.end());
+    return RefineCardsAtPositions(order, id2node, card_num, to_refine);
+}
@@ -3,7 +3,11 @@
 #include <vector>
 #include <unordered_map>
 #include <random>
+#include <string>
+#include <chrono>
 #include "node.h"
+#include "PriorityRule.h"
+#include "Random.h"
 
 // 基于优先级的拓扑排序并分配卡号（可继承父代卡）
 // priority: 节点优先级，数值越小越优先；inherit_cards 可为空，表示不继承
@@ -11,7 +15,7 @@ std::vector<std::pair<int,int>> TopoByPriority(
     const std::unordered_map<int,int>& indeg0,
     const std::unordered_map<int,std::vector<int>>& adj,
     int card_num,
-    std::mt19937& rng,
+    CounterRng& rng,
     const std::unordered_map<int,double>& priority,
     const std::unordered_map<int,int>* inherit_cards);
 
@@ -22,19 +26,42 @@ std::vector<std::pair<int,int>> TopoByPriorityWithEFT(
     const std::unordered_map<int,std::vector<int>>& adj,
     const std::unordered_map<int, const Node*>& id2node,
     int card_num,
-    std::mt19937& rng,
+    CounterRng& rng,
     const std::unordered_map<int,double>& priority,
     const std::unordered_map<int,int>* inherit_cards);
 
+// HEFT upward-rank：rank_u(n) = exec(n) + max_s( transfer(n) + rank_u(s) )
+std::unordered_map<int,double> ComputeUpwardRank(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node);
+
 // 已有拓扑顺序的卡分配局部优化（按比例重选卡，EFT）
 std::vector<std::pair<int,int>> RefineCardsByEFT(
     const std::vector<std::pair<int,int>>& order,
     const std::unordered_map<int, const Node*>& id2node,
     int card_num,
     double refine_ratio,
-    std::mt19937& rng);
+    CounterRng& rng);
+
+// 仅对指定位置（order 下标）按 EFT 重选卡，其余位置保持原卡
+std::vector<std::pair<int,int>> RefineCardsAt(
+    const std::vector<std::pair<int,int>>& order,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    const std::vector<int>& positions);
+
+// 种子报告：启发式名称、makespan 与构造耗时（毫秒）
+struct SeedReport {
+    std::string name;
+    long long makespan;
+    double build_ms;
+};
 
-// 初始种群生成：随机优先级 + 拓扑排序 + 随机卡分配
+// 初始种群生成：贪心 EFT（greedy_seed 为 false 时跳过）、长任务优先、HEFT、按 prio_weights 的参数化优先级、PEFT、DSC、划分（partition_seed 为 true 时构造）、重复子图模板等强种子
+// + 参数化优先级加噪声的拓扑排序
+// report 非空时记录每个种子的构造耗时与 makespan。
+// 按已构造种子的最长耗时预测，下一个种子会越过 deadline 时跳过；一个都放不下时返回非 EFT 的长任务优先兜底种子
 std::vector<std::vector<std::pair<int,int>>> InitializePopulation(
     const std::vector<int>& node_ids,
     const std::unordered_map<int,int>& indeg0,
@@ -42,4 +69,9 @@ std::vector<std::vector<std::pair<int,int>>> InitializePopulation(
     const std::unordered_map<int, const Node*>& id2node,
     int card_num,
     int pop_size,
-    std::mt19937& rng);
\ No newline at end of file
+    bool greedy_seed,
+    bool partition_seed,
+    const PriorityWeights& prio_weights,
+    std::chrono::high_resolution_clock::time_point deadline,
+    CounterRng& rng,
+    std::vector<SeedReport>* report = nullptr);
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "GraphFeatures.h"
+
+#include <algorithm>
+#include <sstream>
+
+GraphFeatures ExtractGraphFeatures(const std::vector<Node*>& all_nodes, int card_num)
+{
+    GraphFeatures f;
+    f.card_num = card_num;
+    const int n = static_cast<int>(all_nodes.size());
+    f.nodes = all_nodes.size();
+    if (n == 0) return f;
+
+    std::vector<int> out_degree(n, 0);
+    std::vector<int> indeg(n, 0);
+    std::vector<std::vector<int>> succ(n);
+    long long total_exec = 0, total_transfer = 0;
+    for (const Node* node : all_nodes) {
+        if (!node) continue;
+        int v = static_cast<int>(node->id());
+        total_exec += node->exec_time();
+        for (const Node* pred : node->inputs()) {
+            if (!pred) continue;
+            int u = static_cast<int>(pred->id());
+            ++out_degree[u];
+            ++indeg[v];
+            succ[u].push_back(v);
+            total_transfer += pred->transfer_time();
+            ++f.edges;
+        }
+    }
+
+    // ASAP 层：入口为第 0 层，其余为前驱最大层 + 1
+    std::vector<int> level(n, 0);
+    std::vector<int> remain = indeg;
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int v = 0; v < n; ++v) if (remain[v] == 0) queue.push_back(v);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        f.depth = std::max(f.depth, level[u] + 1);
+        for (int v : succ[u]) {
+            level[v] = std::max(level[v], level[u] + 1);
+            if (--remain[v] == 0) queue.push_back(v);
+        }
+    }
+    std::vector<int> width(std::max(1, f.depth), 0);
+    for (int v = 0; v < n; ++v) ++width[level[v]];
+    f.max_width = *std::max_element(width.begin(), width.end());
+    f.mean_width = static_cast<double>(n) / std::max(1, f.depth);
+    f.width_per_card = card_num > 0 ? f.mean_width / card_num : 0.0;
+    f.ccr = total_exec > 0 ? static_cast<double>(total_transfer) / total_exec : 0.0;
+
+    // 链边 u->v：u 只有 v 一个消费者、v 只有 u 一个输入；统计被链边覆盖的节点
+    std::vector<char> in_chain(n, 0);
+    for (int u = 0; u < n; ++u) {
+        if (out_degree[u] != 1) continue;
+        int v = succ[u][0];
+        if (indeg[v] == 1) in_chain[u] = in_chain[v] = 1;
+    }
+    f.chain_fraction = static_cast<double>(std::count(in_chain.begin(), in_chain.end(), 1)) / n;
+    return f;
+}
+
+std::string FormatGraphFeatures(const GraphFeatures& f)
+{
+    std::ostringstream os;
+    os << "nodes=" << f.nodes << " edges=" << f.edges << " cards=" << f.card_num
+       << " depth=" << f.depth << " max_width=" << f.max_width
+       << " width/card=" << f.width_per_card << " ccr=" << f.ccr
+       << " chain=" << f.chain_fraction;
+    return os.str();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "node.h"
+
+// 图的廉价结构特征，O(N + E) 一遍拓扑即可得到，用于选择求解策略
+struct GraphFeatures {
+    size_t nodes = 0;
+    size_t edges = 0;
+    int card_num = 0;
+    int depth = 0;              // 最长路径的层数（按节点计）
+    int max_width = 0;          // 按 ASAP 层划分的最宽层节点数
+    double mean_width = 0.0;    // nodes / depth
+    double width_per_card = 0.0; // mean_width / card_num：平均每张卡可并行的节点数
+    double ccr = 0.0;           // 通信计算比：各边 transfer 之和 / 各节点 exec 之和
+    double chain_fraction = 0.0; // 可被链收缩合并的边所连节点占比（u 唯一消费者为 v 且 v 唯一输入为 u）
+};
+
+// 节点 id 需连续（0..n-1）
+GraphFeatures ExtractGraphFeatures(const std::vector<Node*>& all_nodes, int card_num);
+
+// 单行文本，用于日志
+std::string FormatGraphFeatures(const GraphFeatures& f);
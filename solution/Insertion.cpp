@@ -0,0 +1,148 @@
+#include "Insertion.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include "Simulator.h"
+
+namespace {
+
+// 输出执行序中的位置键：追加节点为 (提交序号, 1, ·)，插入节点为 (其后继区间节点的 anchor, 0, 开始时间)
+struct ListKey {
+    long long anchor = -1;
+    int sub = 0;
+    long long start = 0;
+    bool operator<(const ListKey& o) const {
+        return std::tie(anchor, sub, start) < std::tie(o.anchor, o.sub, o.start);
+    }
+};
+
+struct Busy {
+    long long start;
+    long long end;
+    int nid;
+};
+
+} // namespace
+
+std::vector<std::pair<int,int>> BuildInsertionIndividual(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        const std::unordered_map<int,double>& priority,
+        int card_num,
+        long long* predicted)
+{
+    if (card_num <= 0) return {};
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+    if (m == 0) return {};
+
+    SimState st;
+    st.Reset(card_num, m);
+    std::vector<ListKey> key(m), data_since(m); // data_since：数据驻留到当前卡时所在的执行序位置
+    std::vector<int> card_of(m, -1);
+    std::vector<std::vector<Busy>> busy(card_num);
+
+    using Key = std::pair<double,int>;
+    struct PrioCmp {
+        bool operator()(const Key& a, const Key& b) const {
+            if (a.first != b.first) return a.first < b.first; // 优先级大者先出堆
+            return a.second > b.second;
+        }
+    };
+    auto prio_of = [&](int nid) {
+        auto it = priority.find(nid);
+        return it != priority.end() ? it->second : 0.0;
+    };
+    std::priority_queue<Key, std::vector<Key>, PrioCmp> ready;
+    std::unordered_map<int,int> indeg = indeg0;
+    for (const auto& kv : indeg) if (kv.second == 0) ready.push({prio_of(kv.first), kv.first});
+
+    long long commit_idx = 0;
+    int scheduled = 0;
+    while (!ready.empty()) {
+        int v = ready.top().second;
+        ready.pop();
+        const Node* node = nodes[v];
+        const long long exec = node->exec_time();
+
+        long long best_end = std::numeric_limits<long long>::max();
+        int best_card = 0, best_slot = -1; // best_slot >= 0 表示插入到 busy[card][best_slot] 之前
+        long long best_start = 0;
+        for (int c = 0; c < card_num; ++c) {
+            long long e = st.EvalEnd(node, c);
+            if (e >= 0 && e < best_end) { best_end = e; best_card = c; best_slot = -1; best_start = e - exec; }
+        }
+        for (int c = 0; c < card_num; ++c) {
+            // 所有输入数据必须已驻留在 c 上，插入才不涉及入站通道与数据迁移
+            long long local_ft = 0;
+            ListKey need;
+            bool resident = true;
+            for (const Node* pred : node->inputs()) {
+                if (!pred) continue;
+                int pid = static_cast<int>(pred->id());
+                if (st.data_card[pid] != c) { resident = false; break; }
+                local_ft = std::max(local_ft, st.finish_time[pid]);
+                if (need < data_since[pid]) need = data_since[pid];
+            }
+            if (!resident) continue;
+            const auto& iv = busy[c];
+            // 区间结束早于 local_ft + exec 的空闲段放不下，从第一个开始时间 >= local_ft + exec 的区间找起
+            auto it = std::lower_bound(iv.begin(), iv.end(), local_ft + exec,
+                                       [](const Busy& b, long long t){ return b.start < t; });
+            for (size_t i = static_cast<size_t>(it - iv.begin()); i < iv.size(); ++i) {
+                long long gap_start = (i == 0) ? 0 : iv[i - 1].end;
+                long long s = std::max(gap_start, local_ft);
+                if (s + exec > iv[i].start) continue;
+                if (s + exec >= best_end) break;
+                ListKey k{key[iv[i].nid].anchor, 0, s};
+                if (!(need < k)) continue; // 数据在插入位置之后才到达该卡
+                best_end = s + exec; best_card = c; best_slot = static_cast<int>(i); best_start = s;
+                break;
+            }
+        }
+
+        // 提交
+        if (best_slot < 0) {
+            key[v] = {commit_idx++, 1, best_start};
+            for (const Node* pred : node->inputs()) {
+                if (!pred) continue;
+                int pid = static_cast<int>(pred->id());
+                if (st.data_card[pid] != best_card) data_since[pid] = key[v]; // 本节点把数据迁到 best_card
+            }
+            st.Commit(node, best_card);
+            busy[best_card].push_back({best_start, best_end, v});
+        } else {
+            key[v] = {key[busy[best_card][best_slot].nid].anchor, 0, best_start};
+            st.finish_time[v] = best_end;
+            st.data_card[v] = best_card;
+            busy[best_card].insert(busy[best_card].begin() + best_slot, Busy{best_start, best_end, v});
+        }
+        data_since[v] = key[v];
+        card_of[v] = best_card;
+        ++scheduled;
+
+        auto it = adj.find(v);
+        if (it == adj.end()) continue;
+        for (int s : it->second) {
+            if (--indeg[s] == 0) ready.push({prio_of(s), s});
+        }
+    }
+    if (scheduled != static_cast<int>(indeg.size())) return {};
+
+    std::vector<int> ids;
+    ids.reserve(scheduled);
+    for (int i = 0; i < m; ++i) if (card_of[i] >= 0) ids.push_back(i);
+    std::sort(ids.begin(), ids.end(), [&](int a, int b){ return key[a] < key[b]; });
+    std::vector<std::pair<int,int>> order;
+    order.reserve(ids.size());
+    for (int nid : ids) order.emplace_back(nid, card_of[nid]);
+    if (predicted) {
+        long long ms = 0;
+        for (const auto& iv : busy) if (!iv.empty()) ms = std::max(ms, iv.back().end);
+        *predicted = ms;
+    }
+    return order;
+}
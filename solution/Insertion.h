@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 插入式 EFT 解码：按 priority 降序（如 upward-rank）处理节点，每张卡维护已占用区间，
+// 节点可追加到卡尾，也可插入卡上最早能容纳它的空闲区间。
+// 为保证输出执行序在 GetResult 语义下精确复现这些开始时间，插入仅用于不需要跨卡传输的节点：
+// 其所有输入的数据在插入位置之前已驻留在该卡（不占用入站通道、不迁移数据）。
+// 输出的执行序中，插入节点紧排在其空闲区间之后的那个节点之前。
+// predicted 非空时写入解码器预测的 makespan（应与模拟结果一致）
+std::vector<std::pair<int,int>> BuildInsertionIndividual(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    const std::unordered_map<int,double>& priority,
+    int card_num,
+    long long* predicted);
@@ -0,0 +1,87 @@
+#include "Justify.h"
+
+#include <algorithm>
+#include <numeric>
+#include "Simulator.h"
+
+long long ForwardBackwardImprove(
+        std::vector<std::pair<int,int>>& order,
+        long long fit,
+        const std::unordered_map<int, const Node*>& id2node,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        int card_num,
+        int max_iters,
+        JustifyStats* stats)
+{
+    if (stats) stats->calls++;
+    if (order.empty() || card_num <= 0 || max_iters <= 0) return fit;
+    const long long start_fit = fit;
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int n = static_cast<int>(order.size());
+    const int m = static_cast<int>(nodes.size());
+
+    std::vector<int> card(m, 0);
+    std::vector<long long> fwd_finish(m, 0), bwd_finish(m, 0);
+    std::vector<long long> bwd_ready(card_num, 0);
+    std::vector<int> perm(n);
+    std::vector<std::pair<int,int>> cand(n);
+    SimState st;
+
+    // 前向模拟得到完成时间
+    st.Reset(card_num, m);
+    for (int i = 0; i < n; ++i) {
+        const auto& p = order[i];
+        card[p.first] = p.second;
+        fwd_finish[p.first] = st.Commit(nodes[p.first], p.second);
+    }
+
+    for (int iter = 0; iter < max_iters; ++iter) {
+        if (stats) stats->passes++;
+        // 后向：完成越晚越先调度（并列时位置靠后的先，保证反向拓扑合法）
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(), [&](int a, int b){
+            long long fa = fwd_finish[order[a].first], fb = fwd_finish[order[b].first];
+            if (fa != fb) return fa > fb;
+            return a > b;
+        });
+        std::fill(bwd_ready.begin(), bwd_ready.end(), 0);
+        for (int i : perm) {
+            int v = order[i].first;
+            int c = card[v];
+            long long start = bwd_ready[c];
+            auto it = adj.find(v);
+            if (it != adj.end()) {
+                for (int s : it->second) {
+                    long long t = bwd_finish[s] + (card[s] != c ? nodes[v]->transfer_time() : 0);
+                    start = std::max(start, t);
+                }
+            }
+            bwd_finish[v] = start + nodes[v]->exec_time();
+            bwd_ready[c] = bwd_finish[v];
+        }
+
+        // 前向：后向完成时间越大越早开始（并列按原位置，保证拓扑合法）
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(), [&](int a, int b){
+            long long fa = bwd_finish[order[a].first], fb = bwd_finish[order[b].first];
+            if (fa != fb) return fa > fb;
+            return a < b;
+        });
+        st.Reset(card_num, m);
+        for (int i = 0; i < n; ++i) {
+            cand[i] = order[perm[i]];
+            st.Commit(nodes[cand[i].first], cand[i].second);
+        }
+        long long cand_fit = st.Makespan();
+        if (cand_fit >= fit) break;
+        fit = cand_fit;
+        order.swap(cand);
+        for (int i = 0; i < n; ++i) fwd_finish[order[i].first] = st.finish_time[order[i].first];
+    }
+
+    if (stats && fit < start_fit) {
+        stats->improved++;
+        stats->gain += start_fit - fit;
+    }
+    return fit;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 前向-后向改进统计
+struct JustifyStats {
+    long long calls = 0;     // 调用次数
+    long long improved = 0;  // 产生改进的调用次数
+    long long passes = 0;    // 前向+后向迭代总轮数
+    long long gain = 0;      // 累计消除的 makespan
+};
+
+// 前向-后向（justification）改进：卡分配保持不变
+// 1) 按前向完成时间降序在反向 DAG 上列表调度（后向通道）；
+// 2) 按后向完成时间降序（即越晚结束越早开始）重新前向调度；
+// 重复直到 makespan 不再下降或达到 max_iters。order 原地更新，返回新的 makespan
+long long ForwardBackwardImprove(
+    std::vector<std::pair<int,int>>& order,
+    long long fit,
+    const std::unordered_map<int, const Node*>& id2node,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    int card_num,
+    int max_iters,
+    JustifyStats* stats);
@@ -0,0 +1,245 @@
+#include "LNS.h"
+
+#include <algorithm>
+#include <limits>
+#include "Simulator.h"
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+// 单窗口分支定界：前缀状态固定，DFS 枚举窗口内的 (节点, 卡) 序列，叶子处模拟后缀得到完整 makespan
+struct WindowSolver {
+    const std::vector<const Node*>& nodes;
+    const std::vector<long long>& tail;   // 节点完成后至少还需的执行时间（后继链 exec 之和的最大值）
+    const std::vector<std::pair<int,int>>& order;
+    int card_num;
+    long long node_limit;
+    long long leaf_limit;
+    Clock::time_point deadline;
+
+    // 每个窗口的工作区
+    int l = 0, w = 0;
+    SimState st;          // 前缀 + 已放置窗口节点的状态
+    SimState leaf;        // 叶子处模拟后缀的副本
+    std::vector<int> wnodes;                   // 窗口内节点
+    std::vector<int> pending;                  // 窗口内未放置前驱个数
+    std::vector<std::vector<int>> wsucc;       // 窗口内后继（局部下标）
+    std::vector<char> placed;
+    std::vector<SimUndo> undos;
+    std::vector<std::pair<int,int>> cur_seq, best_seq;
+    // 原窗口排列的结束状态：叶子状态若在各维度均不早于它且数据分布相同，则后缀不可能更优
+    SimState ref;
+    std::vector<int> watch;                    // 窗口节点及其前驱（需比较数据所在卡）
+    long long best = 0;
+    long long remaining_exec = 0;              // 未放置节点（窗口 + 后缀）的 exec 之和
+    long long expanded = 0;
+    long long leaves = 0;                      // 已模拟后缀的叶子数
+    bool aborted = false;
+
+    WindowSolver(const std::vector<const Node*>& nodes_,
+                 const std::vector<long long>& tail_,
+                 const std::vector<std::pair<int,int>>& order_,
+                 int card_num_, long long node_limit_, long long leaf_limit_,
+                 Clock::time_point deadline_)
+        : nodes(nodes_), tail(tail_), order(order_), card_num(card_num_),
+          node_limit(node_limit_), leaf_limit(leaf_limit_), deadline(deadline_) {}
+
+    long long LoadBound(long long rem) const {
+        long long sum = rem;
+        for (long long t : st.card_ready) sum += t;
+        return (sum + card_num - 1) / card_num;
+    }
+
+    // 叶子被原窗口排列支配（max-plus 单调性），无需模拟后缀
+    bool DominatedByRef() const {
+        for (int x : watch) if (st.data_card[x] != ref.data_card[x]) return false;
+        for (int k = 0; k < w; ++k) if (st.finish_time[wnodes[k]] < ref.finish_time[wnodes[k]]) return false;
+        for (int c = 0; c < card_num; ++c) {
+            if (st.card_ready[c] < ref.card_ready[c] || st.inbound_ready[c] < ref.inbound_ready[c]) return false;
+        }
+        return true;
+    }
+
+    long long SimulateSuffix() {
+        leaf = st;
+        for (size_t pos = static_cast<size_t>(l + w); pos < order.size(); ++pos) {
+            long long end = leaf.Commit(nodes[order[pos].first], order[pos].second);
+            if (end + tail[order[pos].first] >= best) return std::numeric_limits<long long>::max();
+        }
+        return leaf.Makespan();
+    }
+
+    void Dfs(int depth, long long lb_path) {
+        if (aborted) return;
+        if (++expanded > node_limit) { aborted = true; return; }
+        if ((expanded & 255) == 0 && Clock::now() >= deadline) { aborted = true; return; }
+        if (depth == w) {
+            if (DominatedByRef()) return;
+            if (++leaves > leaf_limit) { aborted = true; return; }
+            // 后缀模拟为 O(n)，每片叶子都检查截止时间
+            if (Clock::now() >= deadline) { aborted = true; return; }
+            long long ms = SimulateSuffix();
+            if (ms < best) { best = ms; best_seq = cur_seq; }
+            return;
+        }
+        struct Cand { long long end; int k; int card; };
+        std::vector<Cand> cands;
+        cands.reserve(static_cast<size_t>(w - depth) * card_num);
+        for (int k = 0; k < w; ++k) {
+            if (placed[k] || pending[k] > 0) continue;
+            const Node* node = nodes[wnodes[k]];
+            for (int c = 0; c < card_num; ++c) cands.push_back({st.EvalEnd(node, c), k, c});
+        }
+        std::sort(cands.begin(), cands.end(), [](const Cand& a, const Cand& b){
+            if (a.end != b.end) return a.end < b.end;
+            if (a.k != b.k) return a.k < b.k;
+            return a.card < b.card;
+        });
+        for (const Cand& cd : cands) {
+            int nid = wnodes[cd.k];
+            long long exec = nodes[nid]->exec_time();
+            long long lb = std::max(lb_path, cd.end + tail[nid]);
+            if (lb >= best) continue;
+            st.Commit(nodes[nid], cd.card, &undos[depth]);
+            remaining_exec -= exec;
+            if (LoadBound(remaining_exec) < best) {
+                placed[cd.k] = 1;
+                for (int s : wsucc[cd.k]) --pending[s];
+                cur_seq[depth] = {nid, cd.card};
+                Dfs(depth + 1, lb);
+                for (int s : wsucc[cd.k]) ++pending[s];
+                placed[cd.k] = 0;
+            }
+            remaining_exec += exec;
+            st.Undo(undos[depth]);
+            if (aborted) return;
+        }
+    }
+
+    // 求解 [l, l+w) 窗口；prefix 为前缀状态，prefix_lb 为前缀节点给出的下界
+    // 找到更优解返回 true，并写入 best_seq/best
+    bool Solve(const SimState& prefix, int l_, int w_, long long prefix_lb,
+               long long rem_exec, long long incumbent) {
+        l = l_; w = w_;
+        st = prefix;
+        wnodes.assign(w, 0);
+        pending.assign(w, 0);
+        wsucc.assign(w, {});
+        placed.assign(w, 0);
+        undos.resize(w);
+        cur_seq.assign(w, {-1, -1});
+        best_seq.clear();
+        best = incumbent;
+        expanded = 0;
+        leaves = 0;
+        aborted = false;
+        remaining_exec = rem_exec;
+        for (int k = 0; k < w; ++k) wnodes[k] = order[l + k].first;
+        ref = prefix;
+        watch.clear();
+        for (int k = 0; k < w; ++k) {
+            const Node* node = nodes[wnodes[k]];
+            ref.Commit(node, order[l + k].second);
+            watch.push_back(wnodes[k]);
+            for (const Node* pred : node->inputs()) if (pred) watch.push_back(static_cast<int>(pred->id()));
+        }
+        long long lb0 = prefix_lb;
+        for (int k = 0; k < w; ++k) {
+            const Node* node = nodes[wnodes[k]];
+            long long est = 0;
+            for (const Node* pred : node->inputs()) {
+                if (!pred) continue;
+                int pid = static_cast<int>(pred->id());
+                auto it = std::find(wnodes.begin(), wnodes.end(), pid);
+                if (it != wnodes.end()) {
+                    ++pending[k];
+                    wsucc[it - wnodes.begin()].push_back(k);
+                } else {
+                    est = std::max(est, st.finish_time[pid]);
+                }
+            }
+            lb0 = std::max(lb0, est + node->exec_time() + tail[wnodes[k]]);
+        }
+        if (lb0 >= best) return false; // 窗口无法改进
+        Dfs(0, lb0);
+        return !best_seq.empty() && best < incumbent;
+    }
+};
+
+} // namespace
+
+long long ImproveByLNS(
+        std::vector<std::pair<int,int>>& order,
+        long long fit,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num,
+        int window,
+        long long node_limit,
+        long long leaf_limit,
+        long long window_limit,
+        std::chrono::high_resolution_clock::time_point deadline,
+        CounterRng& rng,
+        LNSStats* stats)
+{
+    auto t0 = Clock::now();
+    if (stats) { stats->start_fit = fit; stats->end_fit = fit; }
+    int n = static_cast<int>(order.size());
+    window = std::min(window, n);
+    if (card_num <= 0 || window < 2 || fit <= 0) return fit;
+
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    // order 本身即拓扑序
+    std::vector<long long> tail = ComputeTail(order, nodes);
+    long long total_exec = 0;
+    for (const auto& p : order) total_exec += nodes[p.first]->exec_time();
+
+    const int base_window = window;
+    WindowSolver solver(nodes, tail, order, card_num, node_limit, leaf_limit, deadline);
+    SimState prefix;
+    const int stride = std::max(1, window / 2);
+    long long windows = 0, improved = 0, bnb_nodes = 0;
+    bool timeout = false;
+    while (!timeout) {
+        if (Clock::now() >= deadline) break;
+        // 一轮扫描：前缀状态随窗口右移增量推进；起点偏移不超过最后一个能放下窗口的位置
+        std::uniform_int_distribution<int> offset_dist(0, std::min(stride, n - window + 1) - 1);
+        prefix.Reset(card_num, static_cast<int>(nodes.size()));
+        long long prefix_lb = 0, rem_exec = total_exec;
+        int committed = 0;
+        bool sweep_improved = false;
+        for (int l = offset_dist(rng); l + window <= n; l += stride) {
+            if (Clock::now() >= deadline) { timeout = true; break; }
+            if (window_limit > 0 && windows >= window_limit) { timeout = true; break; }
+            for (; committed < l; ++committed) {
+                const auto& p = order[committed];
+                long long end = prefix.Commit(nodes[p.first], p.second);
+                prefix_lb = std::max(prefix_lb, end + tail[p.first]);
+                rem_exec -= nodes[p.first]->exec_time();
+            }
+            ++windows;
+            bool better = solver.Solve(prefix, l, window, prefix_lb, rem_exec, fit);
+            bnb_nodes += solver.expanded;
+            if (better) {
+                for (int k = 0; k < window; ++k) order[l + k] = solver.best_seq[k];
+                fit = solver.best;
+                ++improved;
+                sweep_improved = true;
+            }
+        }
+        // 整轮无改进时扩大窗口（不超过 2 倍初始值），以跳出局部最优
+        if (!sweep_improved && !timeout) {
+            int max_window = std::min(n, 2 * base_window);
+            if (window < max_window) ++window;
+        }
+    }
+
+    if (stats) {
+        stats->windows = windows;
+        stats->improved = improved;
+        stats->bnb_nodes = bnb_nodes;
+        stats->end_fit = fit;
+        stats->elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+    return fit;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include "node.h"
+#include "Random.h"
+
+// LNS 统计：用于评估单位时间的改进量
+struct LNSStats {
+    long long windows = 0;       // 求解的窗口数
+    long long improved = 0;      // 成功替换的窗口数
+    long long bnb_nodes = 0;     // 分支定界展开节点总数
+    long long start_fit = 0;
+    long long end_fit = 0;
+    double elapsed_ms = 0.0;
+};
+
+// 大邻域搜索：反复选取执行序中连续 window 个位置，前缀与后缀固定，
+// 用有界分支定界重新求解窗口内的顺序与卡分配，makespan 变小则替换回原序列。
+// 单窗口展开节点超过 node_limit 或后缀模拟次数超过 leaf_limit 时返回目前最优（即非精确）。
+// 到达 deadline 或求解窗口数达到 window_limit（0 表示不限）时结束。
+// order 原地更新，返回更新后的 makespan；fit 为 order 当前的 makespan
+long long ImproveByLNS(
+    std::vector<std::pair<int,int>>& order,
+    long long fit,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    int window,
+    long long node_limit,
+    long long leaf_limit,
+    long long window_limit,
+    std::chrono::high_resolution_clock::time_point deadline,
+    CounterRng& rng,
+    LNSStats* stats);
@@ -0,0 +1,123 @@
+#include "Multilevel.h"
+
+#include <algorithm>
+#include <tuple>
+
+ContractedGraph CoarsenByMatching(const std::vector<Node*>& nodes, long long max_exec)
+{
+    ContractedGraph g;
+    const int n = static_cast<int>(nodes.size());
+    std::vector<std::vector<int>> preds(n), succs(n);
+    for (const Node* v : nodes) {
+        if (!v) continue;
+        for (const Node* p : v->inputs()) {
+            if (!p) continue;
+            preds[v->id()].push_back(static_cast<int>(p->id()));
+            succs[p->id()].push_back(static_cast<int>(v->id()));
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        std::sort(preds[i].begin(), preds[i].end());
+        preds[i].erase(std::unique(preds[i].begin(), preds[i].end()), preds[i].end());
+        std::sort(succs[i].begin(), succs[i].end());
+        succs[i].erase(std::unique(succs[i].begin(), succs[i].end()), succs[i].end());
+    }
+
+    // 不计通信的 top/bottom level，用于判断合并是否拉长关键路径
+    std::vector<int> topo;
+    topo.reserve(n);
+    {
+        std::vector<int> indeg(n, 0);
+        for (int i = 0; i < n; ++i) indeg[i] = static_cast<int>(preds[i].size());
+        for (int i = 0; i < n; ++i) if (indeg[i] == 0) topo.push_back(i);
+        for (size_t i = 0; i < topo.size(); ++i) {
+            for (int s : succs[topo[i]]) if (--indeg[s] == 0) topo.push_back(s);
+        }
+    }
+    auto exec = [&](int v) { return static_cast<long long>(nodes[v]->exec_time()); };
+    std::vector<long long> tl(n, 0), bl(n, 0);
+    for (int v : topo) for (int p : preds[v]) tl[v] = std::max(tl[v], tl[p] + exec(p));
+    long long cp = 0;
+    for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+        int v = *it;
+        long long tail = 0;
+        for (int s : succs[v]) tail = std::max(tail, bl[s]);
+        bl[v] = exec(v) + tail;
+        cp = std::max(cp, tl[v] + bl[v]);
+    }
+    // 合并 u->v 后粗节点整体开始、整体结束：
+    // v 的其它输入推迟 u 的开始，u 的其它后继推迟到 v 结束；两者都不能超出关键路径长度
+    auto keeps_cp = [&](int u, int v) {
+        long long start = tl[u];
+        for (int p : preds[v]) if (p != u) start = std::max(start, tl[p] + exec(p));
+        long long end = start + exec(u) + exec(v);
+        for (int s : succs[v]) if (end + bl[s] > cp) return false;
+        for (int s : succs[u]) if (s != v && end + bl[s] > cp) return false;
+        return succs[v].empty() ? end <= cp : true;
+    };
+
+    // 候选边：(transfer, u, v)，重边优先
+    std::vector<std::tuple<long long,int,int>> cand;
+    for (int v = 0; v < n; ++v) {
+        for (int u : preds[v]) {
+            if (preds[v].size() != 1 && succs[u].size() != 1) continue;
+            if (exec(u) + exec(v) > max_exec) continue;
+            if (!keeps_cp(u, v)) continue;
+            cand.emplace_back(nodes[u]->transfer_time(), u, v);
+        }
+    }
+    std::sort(cand.begin(), cand.end(), [](const std::tuple<long long,int,int>& a,
+                                           const std::tuple<long long,int,int>& b) {
+        return std::get<0>(a) > std::get<0>(b);
+    });
+    std::vector<int> mate(n, -1);
+    for (const auto& e : cand) {
+        int u = std::get<1>(e), v = std::get<2>(e);
+        if (mate[u] >= 0 || mate[v] >= 0) continue;
+        mate[u] = v;
+        mate[v] = u;
+    }
+
+    // 编号粗节点：成员按 u -> v 的拓扑序
+    std::vector<int> coarse_of(n, -1);
+    for (int i = 0; i < n; ++i) {
+        if (!nodes[i] || coarse_of[i] >= 0) continue;
+        std::vector<int> members{i};
+        if (mate[i] >= 0) {
+            int j = mate[i];
+            bool i_first = std::find(preds[j].begin(), preds[j].end(), i) != preds[j].end();
+            members = i_first ? std::vector<int>{i, j} : std::vector<int>{j, i};
+        }
+        int cid = static_cast<int>(g.members.size());
+        for (int v : members) coarse_of[v] = cid;
+        if (members.size() >= 2) ++g.chains;
+        g.members.push_back(std::move(members));
+    }
+
+    const int k = static_cast<int>(g.members.size());
+    g.owned.reserve(k);
+    for (int c = 0; c < k; ++c) {
+        g.owned.emplace_back(new Node());
+        g.nodes.push_back(g.owned.back().get());
+    }
+    for (int c = 0; c < k; ++c) {
+        long exec = 0, transfer = 0;
+        std::vector<int> in_ids;
+        for (int v : g.members[c]) {
+            exec += nodes[v]->exec_time();
+            bool external = succs[v].empty(); // 出口节点的 transfer 也保留
+            for (int s : succs[v]) if (coarse_of[s] != c) external = true;
+            if (external) transfer = std::max(transfer, nodes[v]->transfer_time());
+            for (int p : preds[v]) {
+                if (coarse_of[p] != c) in_ids.push_back(coarse_of[p]);
+            }
+        }
+        std::sort(in_ids.begin(), in_ids.end());
+        in_ids.erase(std::unique(in_ids.begin(), in_ids.end()), in_ids.end());
+        std::vector<Node*> inputs;
+        inputs.reserve(in_ids.size());
+        for (int p : in_ids) inputs.push_back(g.nodes[p]);
+        *g.owned[c] = Node(static_cast<size_t>(c), inputs, exec, transfer);
+    }
+    return g;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+#include "node.h"
+#include "Contract.h"
+
+// 多级粗化的一层：重边匹配（按 transfer_time 降序），每个节点至多与一个邻居合并。
+// 只合并满足 “v 的唯一前驱是 u” 或 “u 的唯一后继是 v” 的边 u->v，
+// 逐对合并都保持商图无环，因此整层匹配后粗图仍为 DAG。
+// 另外要求合并后（不计通信的）关键路径不变长，避免把关键节点与旁支串在一起。
+// 粗节点 exec 为成员之和，transfer 取有外部消费者的成员中的最大值（近似），输入为外部前驱所在粗节点。
+// 返回的 members 为本层（细图）节点 id，按拓扑序排列，可直接用 ExpandChains 投影回细图
+ContractedGraph CoarsenByMatching(const std::vector<Node*>& nodes, long long max_exec);
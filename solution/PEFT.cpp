@@ -0,0 +1,110 @@
+#include "PEFT.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include "Simulator.h"
+
+OptimisticCostTable BuildOptimisticCostTable(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node)
+{
+    OptimisticCostTable table;
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+    if (m == 0) return table;
+    table.oct.assign(m, 0);
+
+    // 拓扑序
+    std::unordered_map<int,int> indeg = indeg0;
+    std::vector<int> topo;
+    topo.reserve(indeg.size());
+    for (const auto& kv : indeg) if (kv.second == 0) topo.push_back(kv.first);
+    for (size_t i = 0; i < topo.size(); ++i) {
+        auto it = adj.find(topo[i]);
+        if (it == adj.end()) continue;
+        for (int v : it->second) if (--indeg[v] == 0) topo.push_back(v);
+    }
+
+    for (auto it = topo.rbegin(); it != topo.rend(); ++it) {
+        int t = *it;
+        auto jt = adj.find(t);
+        if (jt == adj.end()) continue;
+        long long best = 0;
+        for (int s : jt->second) best = std::max(best, table.oct[s] + nodes[s]->exec_time());
+        table.oct[t] = best;
+    }
+    return table;
+}
+
+std::vector<std::pair<int,int>> BuildPEFTIndividual(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num)
+{
+    if (card_num <= 0) return {};
+    OptimisticCostTable table = BuildOptimisticCostTable(indeg0, adj, id2node);
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    if (nodes.empty() || table.oct.empty()) return {};
+
+    using Key = std::pair<long long,int>;
+    struct RankCmp {
+        bool operator()(const Key& a, const Key& b) const {
+            if (a.first != b.first) return a.first < b.first; // OCT 大者先出堆
+            return a.second > b.second;
+        }
+    };
+    std::priority_queue<Key, std::vector<Key>, RankCmp> ready;
+    std::unordered_map<int,int> indeg = indeg0;
+    for (const auto& kv : indeg) if (kv.second == 0) ready.push({table.oct[kv.first], kv.first});
+
+    SimState st;
+    st.Reset(card_num, static_cast<int>(nodes.size()));
+    std::vector<std::pair<int,int>> order;
+    order.reserve(indeg.size());
+    std::vector<long long> lookahead(card_num), on_card(card_num);
+    while (!ready.empty()) {
+        int nid = ready.top().second;
+        ready.pop();
+        // 前瞻：后继 s 放在卡 w 时需跨卡接收的输入 transfer 之和（已调度输入按其数据所在卡，n 按候选卡 c），
+        // s 取最优的 w；lookahead[c] 为各后继中的最大者
+        std::fill(lookahead.begin(), lookahead.end(), 0);
+        const long long tr_n = nodes[nid]->transfer_time();
+        auto succ = adj.find(nid);
+        if (succ != adj.end()) {
+            for (int s : succ->second) {
+                std::fill(on_card.begin(), on_card.end(), 0);
+                long long total = 0;
+                for (const Node* pred : nodes[s]->inputs()) {
+                    if (!pred || static_cast<int>(pred->id()) == nid) continue;
+                    int dc = st.data_card[pred->id()];
+                    if (dc < 0) continue;
+                    total += pred->transfer_time();
+                    on_card[dc] += pred->transfer_time();
+                }
+                const long long max_on = *std::max_element(on_card.begin(), on_card.end());
+                for (int c = 0; c < card_num; ++c) {
+                    long long cost = total + tr_n - std::max(max_on, on_card[c] + tr_n);
+                    lookahead[c] = std::max(lookahead[c], cost);
+                }
+            }
+        }
+        int best_card = 0;
+        long long best_score = std::numeric_limits<long long>::max();
+        for (int c = 0; c < card_num; ++c) {
+            long long score = st.EvalEnd(nodes[nid], c) + lookahead[c];
+            if (score < best_score) { best_score = score; best_card = c; }
+        }
+        st.Commit(nodes[nid], best_card);
+        order.emplace_back(nid, best_card);
+        auto it = adj.find(nid);
+        if (it == adj.end()) continue;
+        for (int v : it->second) {
+            if (--indeg[v] == 0) ready.push({table.oct[v], v});
+        }
+    }
+    if (order.size() != indeg.size()) return {};
+    return order;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 乐观代价表（OCT）：OCT(t,p) = max_s min_w [ OCT(s,w) + exec(s) + (w != p ? transfer(t) : 0) ]。
+// 卡同构时出口为 0，归纳可知 w = p 总不劣于换卡，OCT(t,·) 与卡无关，
+// 退化为不计通信的 exec 上行路径长度：oct[t] = max_s (oct[s] + exec(s))，按节点存放
+struct OptimisticCostTable {
+    std::vector<long long> oct;
+};
+
+// 逆拓扑构建 OCT（节点 id 需连续）
+OptimisticCostTable BuildOptimisticCostTable(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node);
+
+// PEFT 种子：按 OCT 降序列表调度。静态 OCT 不区分卡，选卡改用随数据位置变化的前瞻：
+// 最小化 EFT(n,p) + max_s min_w [ s 放在卡 w 时，其已调度输入与 n（在卡 p）中不在 w 上者的 transfer 之和 ]，
+// 即把后继拉离其已有输入所在卡的通信代价计入当前选择
+std::vector<std::pair<int,int>> BuildPEFTIndividual(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num);
@@ -0,0 +1,342 @@
+#include "Partition.h"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <tuple>
+
+namespace {
+
+using Edge = std::pair<int,long long>; // (邻居, 边权)
+
+struct PGraph {
+    std::vector<long long> vw;
+    std::vector<std::vector<Edge>> in, out;
+    int size() const { return static_cast<int>(vw.size()); }
+};
+
+// 合并指向同一邻居的平行边
+void MergeParallel(std::vector<Edge>& es) {
+    std::sort(es.begin(), es.end());
+    size_t w = 0;
+    for (size_t i = 0; i < es.size(); ++i) {
+        if (w > 0 && es[w - 1].first == es[i].first) es[w - 1].second += es[i].second;
+        else es[w++] = es[i];
+    }
+    es.resize(w);
+}
+
+// 一层重边匹配：只合并 v 唯一前驱为 u 或 u 唯一后继为 v 的边，商图保持无环；cmap[v] 为所属粗节点
+PGraph Coarsen(const PGraph& g, long long max_vw, std::vector<int>& cmap) {
+    const int n = g.size();
+    std::vector<std::tuple<long long,int,int>> cand;
+    for (int u = 0; u < n; ++u) {
+        for (const Edge& e : g.out[u]) {
+            int v = e.first;
+            if (g.in[v].size() != 1 && g.out[u].size() != 1) continue;
+            if (g.vw[u] + g.vw[v] > max_vw) continue;
+            cand.emplace_back(e.second, u, v);
+        }
+    }
+    std::sort(cand.begin(), cand.end(), [](const std::tuple<long long,int,int>& a,
+                                           const std::tuple<long long,int,int>& b) {
+        return std::get<0>(a) > std::get<0>(b);
+    });
+    std::vector<int> mate(n, -1);
+    for (const auto& c : cand) {
+        int u = std::get<1>(c), v = std::get<2>(c);
+        if (mate[u] >= 0 || mate[v] >= 0) continue;
+        mate[u] = v;
+        mate[v] = u;
+    }
+
+    cmap.assign(n, -1);
+    int cn = 0;
+    for (int v = 0; v < n; ++v) {
+        if (cmap[v] >= 0) continue;
+        cmap[v] = cn;
+        if (mate[v] >= 0) cmap[mate[v]] = cn;
+        ++cn;
+    }
+    PGraph c;
+    c.vw.assign(cn, 0);
+    c.in.resize(cn);
+    c.out.resize(cn);
+    for (int v = 0; v < n; ++v) c.vw[cmap[v]] += g.vw[v];
+    for (int u = 0; u < n; ++u) {
+        for (const Edge& e : g.out[u]) {
+            int cu = cmap[u], cv = cmap[e.first];
+            if (cu == cv) continue;
+            c.out[cu].emplace_back(cv, e.second);
+            c.in[cv].emplace_back(cu, e.second);
+        }
+    }
+    for (int v = 0; v < cn; ++v) {
+        MergeParallel(c.in[v]);
+        MergeParallel(c.out[v]);
+    }
+    return c;
+}
+
+long long CutWeight(const PGraph& g, const std::vector<int>& part) {
+    long long cut = 0;
+    for (int u = 0; u < g.size(); ++u) {
+        for (const Edge& e : g.out[u]) if (part[u] != part[e.first]) cut += e.second;
+    }
+    return cut;
+}
+
+// 初始划分：深度优先倾向的拓扑序（链尽量连续）按累计负载切成 k 段，分区号沿拓扑序单调不减
+std::vector<int> InitialPartition(const PGraph& g, int k) {
+    const int n = g.size();
+    long long total = 0;
+    for (long long w : g.vw) total += w;
+    std::vector<int> indeg(n), stack, part(n, 0);
+    for (int v = 0; v < n; ++v) indeg[v] = static_cast<int>(g.in[v].size());
+    for (int v = n - 1; v >= 0; --v) if (indeg[v] == 0) stack.push_back(v);
+    long long acc = 0;
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        long long mid = acc + g.vw[v] / 2;
+        part[v] = (total > 0) ? static_cast<int>(std::min<long long>(k - 1, mid * k / total)) : 0;
+        acc += g.vw[v];
+        for (auto it = g.out[v].rbegin(); it != g.out[v].rend(); ++it) {
+            if (--indeg[it->first] == 0) stack.push_back(it->first);
+        }
+    }
+    return part;
+}
+
+// 一般 k 路划分的初始解：沿同一拓扑序贪心生长，节点优先跟随边权最大的前驱所在分区；
+// 每个分区的负载不超过“已处理比例 × 平均负载”，让各分区的工作在时间上也大致均衡
+std::vector<int> GrowPartition(const PGraph& g, int k, double imbalance) {
+    const int n = g.size();
+    long long total = 0;
+    for (long long w : g.vw) total += w;
+    std::vector<int> indeg(n), stack, part(n, 0);
+    std::vector<long long> load(k, 0), conn(k, 0);
+    for (int v = 0; v < n; ++v) indeg[v] = static_cast<int>(g.in[v].size());
+    for (int v = n - 1; v >= 0; --v) if (indeg[v] == 0) stack.push_back(v);
+    long long acc = 0;
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        acc += g.vw[v];
+        const long long cap = static_cast<long long>((1.0 + imbalance) * acc / k) + g.vw[v];
+        for (const Edge& e : g.in[v]) conn[part[e.first]] += e.second;
+        int best = static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+        for (int p = 0; p < k; ++p) {
+            if (load[p] + g.vw[v] > cap) continue;
+            if (conn[p] > conn[best] || (conn[p] == conn[best] && load[p] < load[best])) best = p;
+        }
+        for (const Edge& e : g.in[v]) conn[part[e.first]] = 0;
+        part[v] = best;
+        load[best] += g.vw[v];
+        for (auto it = g.out[v].rbegin(); it != g.out[v].rend(); ++it) {
+            if (--indeg[it->first] == 0) stack.push_back(it->first);
+        }
+    }
+    return part;
+}
+
+// 增益桶：按增益分桶，节点在桶内的位置可 O(1) 删除
+class GainBuckets {
+public:
+    explicit GainBuckets(int n) : pos_(n), key_(n, 0), in_(n, 0) {}
+    void Insert(int v, long long gain) {
+        auto& bucket = buckets_[gain];
+        bucket.push_front(v);
+        pos_[v] = bucket.begin();
+        key_[v] = gain;
+        in_[v] = 1;
+    }
+    void Remove(int v) {
+        if (!in_[v]) return;
+        auto it = buckets_.find(key_[v]);
+        it->second.erase(pos_[v]);
+        if (it->second.empty()) buckets_.erase(it);
+        in_[v] = 0;
+    }
+    bool Empty() const { return buckets_.empty(); }
+    int PopMax() {
+        int v = std::prev(buckets_.end())->second.front();
+        Remove(v);
+        return v;
+    }
+private:
+    std::map<long long, std::list<int>> buckets_;
+    std::vector<std::list<int>::iterator> pos_;
+    std::vector<long long> key_;
+    std::vector<char> in_;
+};
+
+struct FMContext {
+    const PGraph& g;
+    int k;
+    bool acyclic;
+    long long max_load;
+    std::vector<int>& part;
+    std::vector<long long> load;
+    std::vector<long long> conn; // 与各分区相连的边权（临时）
+
+    // v 的最优合法移动：目标不超载；无环模式下还须在 [前驱最大分区, 后继最小分区] 内
+    bool BestMove(int v, int& target, long long& gain) {
+        target = -1;
+        gain = 0;
+        int lo = 0, hi = k - 1;
+        if (acyclic) {
+            for (const Edge& e : g.in[v]) lo = std::max(lo, part[e.first]);
+            for (const Edge& e : g.out[v]) hi = std::min(hi, part[e.first]);
+            if (lo >= hi) return false;
+        }
+        for (const Edge& e : g.in[v]) conn[part[e.first]] += e.second;
+        for (const Edge& e : g.out[v]) conn[part[e.first]] += e.second;
+        const int from = part[v];
+        bool found = false;
+        for (int t = lo; t <= hi; ++t) {
+            if (t == from || load[t] + g.vw[v] > max_load) continue;
+            long long gt = conn[t] - conn[from];
+            if (!found || gt > gain || (gt == gain && load[t] < load[target])) {
+                found = true;
+                gain = gt;
+                target = t;
+            }
+        }
+        for (const Edge& e : g.in[v]) conn[part[e.first]] = 0;
+        for (const Edge& e : g.out[v]) conn[part[e.first]] = 0;
+        return found;
+    }
+
+    // 多轮 FM：每轮按增益桶依次移动未锁定节点（允许负增益），回滚到累计增益最大的前缀
+    long long Refine(int passes) {
+        const int n = g.size();
+        load.assign(k, 0);
+        conn.assign(k, 0);
+        for (int v = 0; v < n; ++v) load[part[v]] += g.vw[v];
+        long long kept = 0;
+        const int stall_limit = std::max(50, n / 20);
+        for (int pass = 0; pass < passes; ++pass) {
+            GainBuckets buckets(n);
+            std::vector<char> locked(n, 0);
+            int t = -1;
+            long long gn = 0;
+            for (int v = 0; v < n; ++v) if (BestMove(v, t, gn)) buckets.Insert(v, gn);
+            std::vector<std::pair<int,int>> history; // (节点, 原分区)
+            long long cum = 0, best = 0;
+            size_t best_len = 0;
+            int since_best = 0;
+            while (!buckets.Empty()) {
+                int v = buckets.PopMax();
+                if (!BestMove(v, t, gn)) continue; // 负载变化后已无合法移动
+                const int from = part[v];
+                load[from] -= g.vw[v];
+                load[t] += g.vw[v];
+                part[v] = t;
+                locked[v] = 1;
+                history.emplace_back(v, from);
+                cum += gn;
+                if (cum > best) { best = cum; best_len = history.size(); since_best = 0; }
+                else if (++since_best > stall_limit) break;
+                auto update = [&](int u) {
+                    if (locked[u]) return;
+                    buckets.Remove(u);
+                    int tu = -1;
+                    long long gu = 0;
+                    if (BestMove(u, tu, gu)) buckets.Insert(u, gu);
+                };
+                for (const Edge& e : g.in[v]) update(e.first);
+                for (const Edge& e : g.out[v]) update(e.first);
+            }
+            for (size_t i = history.size(); i > best_len; --i) {
+                int v = history[i - 1].first, from = history[i - 1].second;
+                load[part[v]] -= g.vw[v];
+                load[from] += g.vw[v];
+                part[v] = from;
+            }
+            kept += static_cast<long long>(best_len);
+            if (best <= 0) break;
+        }
+        return kept;
+    }
+};
+
+} // namespace
+
+std::vector<int> KWayPartition(
+        const std::vector<const Node*>& nodes,
+        int k,
+        bool acyclic,
+        double imbalance,
+        int fm_passes,
+        PartitionStats* stats)
+{
+    const int n = static_cast<int>(nodes.size());
+    std::vector<int> part(n, 0);
+    if (k <= 1 || n == 0) return part;
+
+    PGraph g0;
+    g0.vw.assign(n, 0);
+    g0.in.resize(n);
+    g0.out.resize(n);
+    long long total = 0, heaviest = 0;
+    for (int v = 0; v < n; ++v) {
+        if (!nodes[v]) continue;
+        g0.vw[v] = nodes[v]->exec_time();
+        total += g0.vw[v];
+        heaviest = std::max(heaviest, g0.vw[v]);
+        for (const Node* p : nodes[v]->inputs()) {
+            if (!p) continue;
+            int u = static_cast<int>(p->id());
+            g0.out[u].emplace_back(v, p->transfer_time());
+            g0.in[v].emplace_back(u, p->transfer_time());
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        MergeParallel(g0.in[v]);
+        MergeParallel(g0.out[v]);
+    }
+    const long long max_load = std::max(heaviest, static_cast<long long>(total * (1.0 + imbalance) / k));
+
+    // 粗化：单个粗节点不超过平均分区负载的 1/4，保证最粗层仍可均衡切分
+    std::vector<PGraph> levels;
+    std::vector<std::vector<int>> maps;
+    levels.push_back(std::move(g0));
+    const long long max_vw = std::max(1LL, total / (4LL * k));
+    const int coarsest = std::max(100, 30 * k);
+    while (levels.back().size() > coarsest) {
+        std::vector<int> cmap;
+        PGraph c = Coarsen(levels.back(), max_vw, cmap);
+        if (c.size() > levels.back().size() * 0.9) break; // 几乎无法再合并
+        maps.push_back(std::move(cmap));
+        levels.push_back(std::move(c));
+    }
+
+    std::vector<int> cur = acyclic ? InitialPartition(levels.back(), k) : GrowPartition(levels.back(), k, imbalance);
+    long long initial_cut = CutWeight(levels.back(), cur);
+    long long moves = 0;
+    for (size_t lv = levels.size(); lv-- > 0; ) {
+        if (lv + 1 < levels.size()) {
+            // 投影到细一层：细节点继承所属粗节点的分区
+            const std::vector<int>& cmap = maps[lv];
+            std::vector<int> fine(cmap.size());
+            for (size_t v = 0; v < cmap.size(); ++v) fine[v] = cur[cmap[v]];
+            cur.swap(fine);
+        }
+        FMContext fm{levels[lv], k, acyclic, max_load, cur, {}, {}};
+        moves += fm.Refine(fm_passes);
+    }
+
+    if (stats) {
+        stats->initial_cut = initial_cut;
+        stats->cut = CutWeight(levels.front(), cur);
+        std::vector<long long> load(k, 0);
+        for (int v = 0; v < n; ++v) load[cur[v]] += levels.front().vw[v];
+        stats->max_load = *std::max_element(load.begin(), load.end());
+        stats->avg_load = total / k;
+        stats->levels = static_cast<int>(levels.size()) - 1;
+        stats->moves = moves;
+    }
+    return cur;
+}
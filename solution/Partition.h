@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include "node.h"
+
+// 划分统计：割（跨分区边的 transfer_time 之和）与最大分区负载（exec_time 之和）
+struct PartitionStats {
+    long long initial_cut = 0;
+    long long cut = 0;
+    long long max_load = 0;
+    long long avg_load = 0;
+    int levels = 0;   // 粗化层数
+    long long moves = 0;  // FM 保留下来的移动数
+};
+
+// k 路划分：最小化跨分区边的 transfer_time 之和，并让各分区 exec_time 之和不超过平均值的 (1 + imbalance) 倍。
+// 多级：按“唯一前驱/唯一后继”规则做重边匹配粗化（商图保持无环），最粗层求初始解，逐层投影后用带增益桶的 FM 做边界移动。
+// acyclic 为 true 时分区间依赖保持无环：初始解把拓扑序切成 k 段负载均衡的连续段，
+// 移动只在 [前驱最大分区, 后继最小分区] 内进行，分区编号 0..k-1 即分区的拓扑顺序；
+// 为 false 时初始解沿拓扑序贪心生长（跟随通信最重的前驱、按处理进度限制负载），移动不受方向约束。
+// nodes 为按 id 下标的稠密节点表（可含空位），返回 part[id]
+std::vector<int> KWayPartition(
+    const std::vector<const Node*>& nodes,
+    int k,
+    bool acyclic,
+    double imbalance,
+    int fm_passes,
+    PartitionStats* stats);
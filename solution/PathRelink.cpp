@@ -0,0 +1,72 @@
+#include "PathRelink.h"
+
+#include <algorithm>
+#include "Simulator.h"
+
+long long PathRelink(
+        const std::vector<std::pair<int,int>>& from, long long from_fit,
+        const std::vector<std::pair<int,int>>& to, long long to_fit,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num,
+        int max_evals,
+        std::vector<std::pair<int,int>>* best,
+        PathRelinkStats* stats)
+{
+    if (stats) stats->calls++;
+    const int n = static_cast<int>(from.size());
+    if (n == 0 || static_cast<int>(to.size()) != n || card_num <= 0 || max_evals <= 0) return -1;
+    int diff = 0;
+    for (int i = 0; i < n; ++i) if (from[i] != to[i]) ++diff;
+    if (diff <= 1) return -1; // 无中间解
+
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    std::vector<long long> tail = ComputeTail(from, nodes);
+    const long long target = std::min(from_fit, to_fit);
+    long long best_fit = target;
+    bool found = false;
+
+    std::vector<std::pair<int,int>> cur = from;
+    std::vector<int> pos_of(nodes.size(), -1);
+    for (int i = 0; i < n; ++i) pos_of[cur[i].first] = i;
+    SimState pre, tmp;
+    pre.Reset(card_num, static_cast<int>(nodes.size()));
+    const int stride = std::max(1, diff / max_evals);
+    int step = 0;
+    for (int i = 0; i < n; ++i) {
+        bool changed = false;
+        if (cur[i].first != to[i].first) {
+            // to[i] 的前驱在 to[0..i) == cur[0..i) 中，前移合法；被后移的节点不依赖它
+            int j = pos_of[to[i].first];
+            std::rotate(cur.begin() + i, cur.begin() + j, cur.begin() + j + 1);
+            for (int k = i; k <= j; ++k) pos_of[cur[k].first] = k;
+            changed = true;
+        }
+        if (cur[i].second != to[i].second) {
+            cur[i].second = to[i].second;
+            changed = true;
+        }
+        if (changed && (++step % stride) == 0) {
+            // 增量评估：前缀状态复用，只模拟 [i, n)，超过当前最优即剪枝
+            tmp = pre;
+            bool pruned = false;
+            for (int k = i; k < n; ++k) {
+                long long end = tmp.Commit(nodes[cur[k].first], cur[k].second);
+                if (end + tail[cur[k].first] >= best_fit) { pruned = true; break; }
+            }
+            if (stats) stats->evals++;
+            if (!pruned && tmp.Makespan() < best_fit) {
+                best_fit = tmp.Makespan();
+                found = true;
+                if (best) *best = cur;
+            }
+        }
+        pre.Commit(nodes[cur[i].first], cur[i].second);
+    }
+
+    if (!found) return -1;
+    if (stats) {
+        stats->improved++;
+        stats->gain += target - best_fit;
+    }
+    return best_fit;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 路径重连统计
+struct PathRelinkStats {
+    long long calls = 0;
+    long long evals = 0;     // 评估的中间解个数
+    long long improved = 0;  // 找到优于两端点的中间解次数
+    long long gain = 0;      // 相对较优端点的累计改进
+};
+
+// 路径重连：从 from 出发逐位置向 to 靠拢（把 to 在该位置的节点前移到此处、改为 to 的卡），
+// 每一步即一个中间解。前缀状态随位置推进增量维护，中间解只需模拟剩余后缀；
+// 最多评估约 max_evals 个中间解。找到严格优于两端点的中间解时写入 best 并返回其 makespan，否则返回 -1
+long long PathRelink(
+    const std::vector<std::pair<int,int>>& from, long long from_fit,
+    const std::vector<std::pair<int,int>>& to, long long to_fit,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num,
+    int max_evals,
+    std::vector<std::pair<int,int>>* best,
+    PathRelinkStats* stats);
@@ -0,0 +1,35 @@
+#include "Population.h"
+
+#include <algorithm>
+
+PopulationArena::PopulationArena(int rows, int genes)
+    : rows_(rows), genes_(genes),
+      node_(static_cast<size_t>(rows) * genes), card_(static_cast<size_t>(rows) * genes)
+{
+}
+
+void PopulationArena::Store(int row, const std::vector<std::pair<int,int>>& indiv)
+{
+    const size_t base = static_cast<size_t>(row) * genes_;
+    const size_t n = std::min(indiv.size(), static_cast<size_t>(genes_));
+    for (size_t i = 0; i < n; ++i) {
+        node_[base + i] = static_cast<uint32_t>(indiv[i].first);
+        card_[base + i] = static_cast<uint16_t>(indiv[i].second);
+    }
+}
+
+void PopulationArena::Load(int row, std::vector<std::pair<int,int>>& out) const
+{
+    const size_t base = static_cast<size_t>(row) * genes_;
+    out.resize(genes_);
+    for (int i = 0; i < genes_; ++i) {
+        out[i] = { static_cast<int>(node_[base + i]), static_cast<int>(card_[base + i]) };
+    }
+}
+
+bool PopulationArena::Equal(int a, int b) const
+{
+    const size_t pa = static_cast<size_t>(a) * genes_, pb = static_cast<size_t>(b) * genes_;
+    return std::equal(node_.begin() + pa, node_.begin() + pa + genes_, node_.begin() + pb)
+        && std::equal(card_.begin() + pa, card_.begin() + pa + genes_, card_.begin() + pb);
+}
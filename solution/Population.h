@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// 基因池中一行的只读视图，不拷贝；operator[] 返回 (节点, 卡)，供交叉与卡号对齐直接读取父代
+class RowView {
+public:
+    RowView(const uint32_t* node, const uint16_t* card, size_t size) : node_(node), card_(card), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::pair<int,int> operator[](size_t i) const {
+        return { static_cast<int>(node_[i]), static_cast<int>(card_[i]) };
+    }
+
+private:
+    const uint32_t* node_;
+    const uint16_t* card_;
+    size_t size_;
+};
+
+// 种群基因池：所有个体按行存放在同一块连续内存中，节点 id（uint32）与卡号（uint16）分开存放（SoA），
+// 每个基因 6 字节、整个种群只有两次分配。行号即个体句柄：精英跨代只传递行号，子代写入空闲行。
+// 交叉与卡号对齐通过 Row 只读访问父代；变异、解码等算子仍作用于 vector<pair<int,int>>，
+// 通过 Load / Store 在行与暂存缓冲之间转换。
+// 卡号需小于 65536
+class PopulationArena {
+public:
+    PopulationArena(int rows, int genes);
+
+    int rows() const { return rows_; }
+    int genes() const { return genes_; }
+
+    void Store(int row, const std::vector<std::pair<int,int>>& indiv);
+    void Load(int row, std::vector<std::pair<int,int>>& out) const;
+    bool Equal(int a, int b) const;
+    RowView Row(int row) const {
+        const size_t base = static_cast<size_t>(row) * genes_;
+        return RowView(node_.data() + base, card_.data() + base, static_cast<size_t>(genes_));
+    }
+
+    size_t Bytes() const { return node_.size() * sizeof(uint32_t) + card_.size() * sizeof(uint16_t); }
+
+private:
+    int rows_;
+    int genes_;
+    std::vector<uint32_t> node_;
+    std::vector<uint16_t> card_;
+};
@@ -0,0 +1,84 @@
+#include "PriorityRule.h"
+
+#include <algorithm>
+#include <queue>
+#include "GAInit.h"
+
+const char* PriorityFeatureName(int feature)
+{
+    static const char* const kNames[kPriorityFeatureNum] = {
+        "exec", "transfer", "up_rank", "down_rank", "out_degree", "slack"};
+    return (feature >= 0 && feature < kPriorityFeatureNum) ? kNames[feature] : "";
+}
+
+std::unordered_map<int, PriorityFeatures> ComputePriorityFeatures(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node)
+{
+    // 拓扑序
+    std::unordered_map<int,int> indeg = indeg0;
+    std::queue<int> q;
+    for (const auto& kv : indeg) if (kv.second == 0) q.push(kv.first);
+    std::vector<int> topo;
+    topo.reserve(indeg.size());
+    while (!q.empty()) {
+        int u = q.front(); q.pop();
+        topo.push_back(u);
+        auto it = adj.find(u);
+        if (it == adj.end()) continue;
+        for (int v : it->second) if (--indeg[v] == 0) q.push(v);
+    }
+
+    auto rank_u = ComputeUpwardRank(indeg0, adj, id2node);
+    // downward-rank：rank_d(v) = max_p( rank_d(p) + exec(p) + transfer(p) )
+    std::unordered_map<int,double> rank_d;
+    rank_d.reserve(topo.size());
+    for (int u : topo) rank_d[u] += 0.0;
+    double cp = 0.0;
+    for (int u : topo) {
+        const Node* node = id2node.at(u);
+        cp = std::max(cp, rank_d[u] + rank_u[u]);
+        auto it = adj.find(u);
+        if (it == adj.end()) continue;
+        double out = rank_d[u] + node->exec_time() + node->transfer_time();
+        for (int v : it->second) rank_d[v] = std::max(rank_d[v], out);
+    }
+
+    std::unordered_map<int, PriorityFeatures> features;
+    features.reserve(topo.size());
+    PriorityFeatures max_f{};
+    for (int u : topo) {
+        const Node* node = id2node.at(u);
+        auto it = adj.find(u);
+        PriorityFeatures f;
+        f[kFeatExec] = static_cast<double>(node->exec_time());
+        f[kFeatTransfer] = static_cast<double>(node->transfer_time());
+        f[kFeatUpRank] = rank_u[u];
+        f[kFeatDownRank] = rank_d[u];
+        f[kFeatOutDegree] = it == adj.end() ? 0.0 : static_cast<double>(it->second.size());
+        f[kFeatSlack] = std::max(0.0, cp - rank_u[u] - rank_d[u]);
+        for (int i = 0; i < kPriorityFeatureNum; ++i) max_f[i] = std::max(max_f[i], f[i]);
+        features[u] = f;
+    }
+    for (auto& kv : features) {
+        for (int i = 0; i < kPriorityFeatureNum; ++i) {
+            if (max_f[i] > 0.0) kv.second[i] /= max_f[i];
+        }
+    }
+    return features;
+}
+
+std::unordered_map<int,double> WeightedPriority(
+        const std::unordered_map<int, PriorityFeatures>& features,
+        const PriorityWeights& weights)
+{
+    std::unordered_map<int,double> prio;
+    prio.reserve(features.size());
+    for (const auto& kv : features) {
+        double score = 0.0;
+        for (int i = 0; i < kPriorityFeatureNum; ++i) score += weights[i] * kv.second[i];
+        prio[kv.first] = -score;
+    }
+    return prio;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "node.h"
+
+// 参数化优先级的节点特征，均按图内最大值归一化到 [0, 1]
+enum PriorityFeature {
+    kFeatExec,       // 执行时间
+    kFeatTransfer,   // 输出传输时间
+    kFeatUpRank,     // HEFT upward-rank（到出口的最长路径，含自身与传输）
+    kFeatDownRank,   // downward-rank（从入口到本节点开始的最长路径）
+    kFeatOutDegree,  // 消费者数
+    kFeatSlack,      // 关键路径长度 - (upward + downward)，即可推迟量
+    kPriorityFeatureNum
+};
+
+using PriorityFeatures = std::array<double, kPriorityFeatureNum>;
+using PriorityWeights = std::array<double, kPriorityFeatureNum>;
+
+// 特征名（与 PriorityFeature 顺序一致），用于配置键与训练输出
+const char* PriorityFeatureName(int feature);
+
+// 计算每个节点的归一化特征
+std::unordered_map<int, PriorityFeatures> ComputePriorityFeatures(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node);
+
+// 加权优先级：score = Σ w_i·f_i，score 越大越先调度；返回值取反，符合 TopoByPriority 的“越小越优先”约定
+std::unordered_map<int,double> WeightedPriority(
+    const std::unordered_map<int, PriorityFeatures>& features,
+    const PriorityWeights& weights);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// 计数器式随机数流：第 i 个输出 = splitmix64(key + i·黄金比例常数)，只由 (key, i) 决定。
+// Fork 由当前 key 与流号派生互不相关的子流（线程、分组、代、个体各用一条），
+// 同一种子下结果与线程数、执行快慢无关。满足 UniformRandomBitGenerator，可直接配合 <random> 的分布使用
+class CounterRng {
+public:
+    using result_type = uint64_t;
+
+    explicit CounterRng(uint64_t seed = 0) : key_(Mix(seed)) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return Mix(key_ + kGolden * ++counter_); }
+
+    CounterRng Fork(uint64_t stream) const
+    {
+        CounterRng r;
+        r.key_ = Mix(key_ ^ Mix(stream + kGolden));
+        return r;
+    }
+
+    uint64_t counter() const { return counter_; }
+
+private:
+    static constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+    static uint64_t Mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key_;
+    uint64_t counter_ = 0;
+};
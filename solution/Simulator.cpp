@@ -0,0 +1,181 @@
+#include "Simulator.h"
+
+#include <algorithm>
+
+void SimState::Reset(int card_num, int node_count) {
+    card_ready.assign(card_num, 0);
+    inbound_ready.assign(card_num, 0);
+    data_card.assign(node_count, -1);
+    finish_time.assign(node_count, -1);
+}
+
+namespace {
+
+// 评估/提交的公共实现，S 为 SimState 或 SimSnapshot
+template <class S>
+long long EvalEndImpl(const S& s, const Node* node, int card, std::vector<SimCross>& cross) {
+    long long local_max = 0;
+    cross.clear();
+    for (const Node* pred : node->inputs()) {
+        if (!pred) continue;
+        int pid = static_cast<int>(pred->id());
+        long long ft = s.Finish(pid);
+        if (ft < 0) return -1;
+        if (s.DataCard(pid) == card) {
+            local_max = std::max(local_max, ft);
+        } else {
+            cross.push_back({ft, pred->transfer_time(), pid});
+        }
+    }
+    long long last_arrival = 0;
+    if (!cross.empty()) {
+        std::sort(cross.begin(), cross.end(), [](const SimCross& x, const SimCross& y){ return x.finish < y.finish; });
+        long long tmp = s.inbound_ready[card];
+        for (const auto& rec : cross) tmp = std::max(tmp, rec.finish) + rec.transfer;
+        last_arrival = tmp;
+    }
+    long long start = std::max(s.card_ready[card], std::max(local_max, last_arrival));
+    return start + node->exec_time();
+}
+
+template <class S>
+long long CommitImpl(S& s, const Node* node, int card, std::vector<SimCross>& cross,
+                     SimUndo* undo, SimBind* bind) {
+    int nid = static_cast<int>(node->id());
+    if (undo) {
+        undo->nid = nid;
+        undo->card = card;
+        undo->card_ready = s.card_ready[card];
+        undo->inbound_ready = s.inbound_ready[card];
+        undo->moved.clear();
+    }
+    // 与 GetResult 一致：先收集跨卡输入，再统一标记数据驻留到目的卡
+    long long local_max = 0;
+    int local_src = -1;
+    cross.clear();
+    for (const Node* pred : node->inputs()) {
+        if (!pred) continue;
+        int pid = static_cast<int>(pred->id());
+        long long ft = s.Finish(pid);
+        if (s.DataCard(pid) == card) {
+            if (ft > local_max || local_src < 0) local_src = pid;
+            local_max = std::max(local_max, ft);
+        } else {
+            cross.push_back({ft, pred->transfer_time(), pid});
+        }
+    }
+    long long last_arrival = 0;
+    int burst_src = -1; // 最后一段连续传输由哪个输入的完成时间触发
+    if (!cross.empty()) {
+        std::sort(cross.begin(), cross.end(), [](const SimCross& x, const SimCross& y){ return x.finish < y.finish; });
+        long long tmp = s.inbound_ready[card];
+        for (const auto& rec : cross) {
+            if (rec.finish >= tmp) burst_src = rec.pid;
+            tmp = std::max(tmp, rec.finish) + rec.transfer;
+        }
+        s.inbound_ready[card] = tmp;
+        last_arrival = tmp;
+        for (const auto& rec : cross) {
+            if (undo) undo->moved.emplace_back(rec.pid, s.DataCard(rec.pid));
+            s.SetDataCard(rec.pid, card);
+        }
+    }
+    long long start = std::max(s.card_ready[card], std::max(local_max, last_arrival));
+    if (bind) {
+        if (start == 0) {
+            *bind = {BindKind::kNone, -1};
+        } else if (!cross.empty() && last_arrival == start) {
+            *bind = (burst_src >= 0) ? SimBind{BindKind::kTransfer, burst_src} : SimBind{BindKind::kInboundBusy, -1};
+        } else if (local_src >= 0 && local_max == start) {
+            *bind = {BindKind::kLocalDep, local_src};
+        } else {
+            *bind = {BindKind::kCardBusy, -1};
+        }
+    }
+    long long end = start + node->exec_time();
+    s.card_ready[card] = end;
+    s.SetFinish(nid, end);
+    s.SetDataCard(nid, card);
+    return end;
+}
+
+long long MaxReady(const std::vector<long long>& card_ready) {
+    long long ms = 0;
+    for (long long t : card_ready) ms = std::max(ms, t);
+    return ms;
+}
+
+} // namespace
+
+long long SimState::EvalEnd(const Node* node, int card) const {
+    return EvalEndImpl(*this, node, card, cross_);
+}
+
+long long SimState::Commit(const Node* node, int card, SimUndo* undo, SimBind* bind) {
+    return CommitImpl(*this, node, card, cross_, undo, bind);
+}
+
+void SimState::Undo(const SimUndo& undo) {
+    for (auto it = undo.moved.rbegin(); it != undo.moved.rend(); ++it) data_card[it->first] = it->second;
+    card_ready[undo.card] = undo.card_ready;
+    inbound_ready[undo.card] = undo.inbound_ready;
+    finish_time[undo.nid] = -1;
+    data_card[undo.nid] = -1;
+}
+
+long long SimState::Makespan() const {
+    return MaxReady(card_ready);
+}
+
+void SimSnapshot::Reset(int card_num, int node_count) {
+    card_ready.assign(card_num, 0);
+    inbound_ready.assign(card_num, 0);
+    data_card.Assign(node_count, -1);
+    finish_time.Assign(node_count, -1);
+}
+
+long long SimSnapshot::EvalEnd(const Node* node, int card) const {
+    return EvalEndImpl(*this, node, card, cross_);
+}
+
+long long SimSnapshot::Commit(const Node* node, int card) {
+    return CommitImpl(*this, node, card, cross_, nullptr, nullptr);
+}
+
+long long SimSnapshot::Makespan() const {
+    return MaxReady(card_ready);
+}
+
+std::vector<const Node*> DenseNodes(const std::unordered_map<int, const Node*>& id2node) {
+    int max_id = -1;
+    for (const auto& kv : id2node) if (kv.second) max_id = std::max(max_id, kv.first);
+    std::vector<const Node*> nodes(max_id + 1, nullptr);
+    for (const auto& kv : id2node) if (kv.second) nodes[kv.first] = kv.second;
+    return nodes;
+}
+
+long long SimulateOrder(const std::vector<std::pair<int,int>>& order,
+                        const std::vector<const Node*>& nodes,
+                        int card_num) {
+    SimState st;
+    st.Reset(card_num, static_cast<int>(nodes.size()));
+    for (const auto& p : order) st.Commit(nodes[p.first], p.second);
+    return st.Makespan();
+}
+
+std::vector<long long> ComputeTail(const std::vector<std::pair<int,int>>& order,
+                                   const std::vector<const Node*>& nodes) {
+    std::vector<long long> blevel(nodes.size(), 0);
+    for (const auto& p : order) blevel[p.first] = nodes[p.first]->exec_time();
+    // 逆拓扑序传播：blevel(p) = exec(p) + max_s blevel(s)
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int v = it->first;
+        for (const Node* pred : nodes[v]->inputs()) {
+            if (!pred) continue;
+            int pid = static_cast<int>(pred->id());
+            blevel[pid] = std::max(blevel[pid], nodes[pid]->exec_time() + blevel[v]);
+        }
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) if (nodes[i]) blevel[i] -= nodes[i]->exec_time();
+    return blevel;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <memory>
+#include "node.h"
+
+// 与 GetResult / CalcTotalDuration 语义一致的逐步调度状态
+// 节点 id 需连续（0..n-1），按执行序逐个提交 (node, card)
+struct SimUndo {
+    int nid = -1;
+    int card = -1;
+    long long card_ready = 0;
+    long long inbound_ready = 0;
+    std::vector<std::pair<int,int>> moved; // (pred id, 迁移前所在卡)
+};
+
+// 节点开始时间的约束来源
+enum class BindKind : char {
+    kNone,        // 从 0 时刻开始
+    kCardBusy,    // 本卡上一个节点刚结束
+    kLocalDep,    // 同卡输入完成
+    kTransfer,    // 跨卡输入传输到达（from 为启动该段连续传输的输入）
+    kInboundBusy  // 入站通道被更早的传输占用
+};
+
+struct SimBind {
+    BindKind kind = BindKind::kNone;
+    int from = -1; // kLocalDep / kTransfer 时为对应输入节点 id
+};
+
+// 评估用的跨卡输入记录
+struct SimCross { long long finish; long long transfer; int pid; };
+
+struct SimState {
+    std::vector<long long> card_ready;
+    std::vector<long long> inbound_ready;
+    std::vector<int> data_card;          // 数据当前所在卡，-1 表示未产生
+    std::vector<long long> finish_time;  // 节点完成时间，-1 表示未执行
+
+    void Reset(int card_num, int node_count);
+
+    // 评估 node 放到 card 上的完成时间，不修改状态；输入未完成返回 -1
+    long long EvalEnd(const Node* node, int card) const;
+
+    // 提交 node 到 card，返回完成时间；undo 非空时记录回滚信息，bind 非空时记录开始时间的约束来源
+    long long Commit(const Node* node, int card, SimUndo* undo = nullptr, SimBind* bind = nullptr);
+
+    // 回滚最近一次 Commit
+    void Undo(const SimUndo& undo);
+
+    long long Makespan() const;
+
+    long long Finish(int nid) const { return finish_time[nid]; }
+    int DataCard(int nid) const { return data_card[nid]; }
+    void SetFinish(int nid, long long t) { finish_time[nid] = t; }
+    void SetDataCard(int nid, int c) { data_card[nid] = c; }
+
+private:
+    // 评估用的跨卡输入缓冲，避免反复分配
+    mutable std::vector<SimCross> cross_;
+};
+
+// 写时复制数组：按块共享存储，拷贝只复制块指针，写入时仅复制被修改且仍被共享的块
+template <class T>
+class CowArray {
+public:
+    enum { kBlock = 256 };
+
+    void Assign(int n, const T& v) {
+        blocks_.clear();
+        size_ = 0;
+        for (int i = 0; i < n; i += kBlock) blocks_.push_back(std::make_shared<std::vector<T>>(kBlock, v));
+        size_ = n;
+    }
+    int size() const { return size_; }
+    const T& Get(int i) const { return (*blocks_[i / kBlock])[i % kBlock]; }
+    void Set(int i, const T& v) { (*Own(i / kBlock))[i % kBlock] = v; }
+    void PushBack(const T& v) {
+        if (size_ % kBlock == 0) blocks_.push_back(std::make_shared<std::vector<T>>(kBlock));
+        Set(size_++, v);
+    }
+
+private:
+    std::shared_ptr<std::vector<T>>& Own(int b) {
+        if (blocks_[b].use_count() > 1) blocks_[b] = std::make_shared<std::vector<T>>(*blocks_[b]);
+        return blocks_[b];
+    }
+    std::vector<std::shared_ptr<std::vector<T>>> blocks_;
+    int size_ = 0;
+};
+
+// 可廉价拷贝的调度快照：与 SimState 语义相同，节点级数组写时复制，
+// 适合束搜索等需要大量分叉部分状态的场景
+struct SimSnapshot {
+    std::vector<long long> card_ready;
+    std::vector<long long> inbound_ready;
+    CowArray<int> data_card;
+    CowArray<long long> finish_time;
+
+    void Reset(int card_num, int node_count);
+    long long EvalEnd(const Node* node, int card) const;
+    long long Commit(const Node* node, int card);
+    long long Makespan() const;
+
+    long long Finish(int nid) const { return finish_time.Get(nid); }
+    int DataCard(int nid) const { return data_card.Get(nid); }
+    void SetFinish(int nid, long long t) { finish_time.Set(nid, t); }
+    void SetDataCard(int nid, int c) { data_card.Set(nid, c); }
+
+private:
+    mutable std::vector<SimCross> cross_;
+};
+
+// 将 id2node 展开为按 id 下标的稠密数组（缺失 id 为 nullptr）
+std::vector<const Node*> DenseNodes(const std::unordered_map<int, const Node*>& id2node);
+
+// 从头模拟完整执行序，返回 makespan（不做合法性检查）
+long long SimulateOrder(const std::vector<std::pair<int,int>>& order,
+                        const std::vector<const Node*>& nodes,
+                        int card_num);
+
+// tail[u]：u 完成后其后继链上至少还需的执行时间（不含 u 本身），用于 makespan 下界
+// order 需为拓扑序，节点按 id 下标
+std::vector<long long> ComputeTail(const std::vector<std::pair<int,int>>& order,
+                                   const std::vector<const Node*>& nodes);
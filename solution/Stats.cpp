@@ -0,0 +1,34 @@
+#include "Stats.h"
+
+#include <sstream>
+
+void SolveStats::Merge(const SolveStats& other) {
+    evaluations += other.evaluations;
+    cache_hits += other.cache_hits;
+    duration_calls += other.duration_calls;
+    decodes += other.decodes;
+    generations += other.generations;
+    improvements += other.improvements;
+    crossover_ms += other.crossover_ms;
+    mutate_ms += other.mutate_ms;
+    refine_ms += other.refine_ms;
+    duration_ms += other.duration_ms;
+    total_ms += other.total_ms;
+}
+
+std::string FormatSolveStats(const SolveStats& s) {
+    std::ostringstream out;
+    out << "evaluations=" << s.evaluations
+        << " cache_hits=" << s.cache_hits
+        << " hit_rate=" << (s.evaluations > 0 ? static_cast<double>(s.cache_hits) / s.evaluations : 0.0)
+        << " duration_calls=" << s.duration_calls
+        << " decodes=" << s.decodes
+        << " generations=" << s.generations
+        << " improvements=" << s.improvements
+        << " crossover_ms=" << s.crossover_ms
+        << " mutate_ms=" << s.mutate_ms
+        << " refine_ms=" << s.refine_ms
+        << " duration_ms=" << s.duration_ms
+        << " total_ms=" << s.total_ms;
+    return out.str();
+}
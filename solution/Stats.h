@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// 求解热路径统计：评估、解码、缓存命中、代数、改进次数与各算子耗时。
+// 仅在定义 EO_STATS（CMake 选项 -DEO_STATS=ON）时由 EO_STAT / EO_STAT_TIMER 累计，否则两个宏展开为空语句、不产生开销
+struct SolveStats {
+    long long evaluations = 0;    // 适应度评估请求（含缓存命中）
+    long long cache_hits = 0;     // 其中命中适应度缓存的次数
+    long long duration_calls = 0; // 实际调用 CalcTotalDuration 的次数
+    long long decodes = 0;        // 优先级候选的 EFT 解码次数（保序交叉子代无需解码，不计）
+    long long generations = 0;    // 完成的 GA 代数（各子问题、各粗化层累加）
+    long long improvements = 0;   // 最优解刷新次数（GA 代间与 LNS 窗口）
+    double crossover_ms = 0;      // 交叉构造与解码（不含评估）
+    double mutate_ms = 0;         // 变异（不含评估）
+    double refine_ms = 0;         // 前向-后向改进、路径重连与 LNS
+    double duration_ms = 0;       // CalcTotalDuration 内
+    double total_ms = 0;          // ExecuteOrder 全程
+
+    void Merge(const SolveStats& other);
+};
+
+// 单行 key=value 格式，供日志输出
+std::string FormatSolveStats(const SolveStats& s);
+
+// 作用域计时：析构时把经过的毫秒数累加到 *ms
+class StatTimer {
+public:
+    explicit StatTimer(double* ms) : ms_(ms), t0_(std::chrono::high_resolution_clock::now()) {}
+    ~StatTimer() {
+        *ms_ += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0_).count();
+    }
+    StatTimer(const StatTimer&) = delete;
+    StatTimer& operator=(const StatTimer&) = delete;
+
+private:
+    double* ms_;
+    std::chrono::high_resolution_clock::time_point t0_;
+};
+
+#define EO_STAT_JOIN_(a, b) a##b
+#define EO_STAT_JOIN(a, b) EO_STAT_JOIN_(a, b)
+
+#ifdef EO_STATS
+#define EO_STAT(...) do { __VA_ARGS__; } while (0)
+#define EO_STAT_TIMER(ms) StatTimer EO_STAT_JOIN(stat_timer_, __LINE__)(ms)
+#else
+#define EO_STAT(...) do { } while (0)
+#define EO_STAT_TIMER(ms) do { } while (0)
+#endif
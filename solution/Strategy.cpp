@@ -0,0 +1,26 @@
+#include "Strategy.h"
+
+StrategyChoice SelectStrategy(const GraphFeatures& f, GAConfig& cfg)
+{
+    StrategyChoice choice;
+    if (f.width_per_card >= 2.0) {
+        choice.name = "balance";
+        cfg.comp_enabled = false;
+        cfg.beam_width = 0;
+        cfg.greedy_seed = false;
+        cfg.bandit_enabled = false;
+        cfg.pop_size = 3;
+        choice.changes = "comp_enabled=false beam_width=0 greedy_seed=false bandit_enabled=false pop_size=3";
+    } else if (f.width_per_card < 1.0 && f.chain_fraction >= 0.9 && f.nodes < 1000) {
+        choice.name = "chain";
+        cfg.lns_time_share = 0.5;
+        choice.changes = "lns_time_share=0.5";
+    } else if (f.width_per_card < 2.0 && f.width_per_card >= 1.0) {
+        choice.name = "mixed";
+        cfg.pop_size = 3;
+        choice.changes = "pop_size=3";
+    } else {
+        choice.name = "default";
+    }
+    return choice;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include "GAConfig.h"
+#include "GraphFeatures.h"
+
+// 按图特征选择的求解策略：name 为规则名，changes 为被改动的配置项（日志用）
+struct StrategyChoice {
+    std::string name;
+    std::string changes;
+};
+
+// 在 cfg 上应用按特征选出的求解模式、种群规模与算子组合：
+// balance   每卡平均可并行节点数 >= 2：负载均衡主导，插入式 HEFT 类种子通常已达下界，
+//           改为平铺求解并关闭束搜索、贪心 EFT 种子（宽图上为 O(N·宽度·卡数)）与老虎机，小种群；
+// chain     窄（每卡 < 1）、链占比 >= 0.9 的小图：顺序决定 makespan，LNS 份额提高到 0.5；
+// mixed     每卡 1~2 个可并行节点：小种群换更多代数；
+// default   其余保持默认
+StrategyChoice SelectStrategy(const GraphFeatures& f, GAConfig& cfg);
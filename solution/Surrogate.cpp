@@ -0,0 +1,56 @@
+#include "Surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "GAInit.h"
+#include "Simulator.h"
+
+long long SurrogateScore(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::vector<const Node*>& nodes,
+        int card_num,
+        const std::unordered_map<int,double>& priority,
+        const std::unordered_map<int,int>& inherit_cards,
+        CounterRng& rng)
+{
+    auto order = TopoByPriority(indeg0, adj, card_num, rng, priority, &inherit_cards);
+    if (order.empty()) return -1;
+    return SimulateOrder(order, nodes, card_num);
+}
+
+namespace {
+
+std::vector<double> Ranks(const std::vector<double>& v)
+{
+    std::vector<int> idx(v.size());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::sort(idx.begin(), idx.end(), [&](int a, int b){ return v[a] < v[b]; });
+    std::vector<double> rank(v.size());
+    for (size_t i = 0; i < idx.size();) {
+        size_t j = i;
+        while (j + 1 < idx.size() && v[idx[j + 1]] == v[idx[i]]) ++j;
+        for (size_t k = i; k <= j; ++k) rank[idx[k]] = (i + j) / 2.0;
+        i = j + 1;
+    }
+    return rank;
+}
+
+} // namespace
+
+double SpearmanCorrelation(const std::vector<double>& a, const std::vector<double>& b)
+{
+    if (a.size() < 2 || a.size() != b.size()) return 0.0;
+    std::vector<double> ra = Ranks(a), rb = Ranks(b);
+    double ma = std::accumulate(ra.begin(), ra.end(), 0.0) / ra.size();
+    double mb = std::accumulate(rb.begin(), rb.end(), 0.0) / rb.size();
+    double num = 0.0, da = 0.0, db = 0.0;
+    for (size_t i = 0; i < ra.size(); ++i) {
+        num += (ra[i] - ma) * (rb[i] - mb);
+        da += (ra[i] - ma) * (ra[i] - ma);
+        db += (rb[i] - mb) * (rb[i] - mb);
+    }
+    if (da <= 0.0 || db <= 0.0) return 0.0;
+    return num / std::sqrt(da * db);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include "node.h"
+#include "Random.h"
+
+// 子代代理评分：不做 EFT 解码，直接按交叉得到的优先级做拓扑排序、卡号取继承卡，
+// 再模拟该执行序的 makespan。代价约为一次 EFT 解码的四分之一，用于在解码前筛选交叉候选
+long long SurrogateScore(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::vector<const Node*>& nodes,
+    int card_num,
+    const std::unordered_map<int,double>& priority,
+    const std::unordered_map<int,int>& inherit_cards,
+    CounterRng& rng);
+
+// Spearman 秩相关系数（并列取平均秩），样本少于 2 个返回 0
+double SpearmanCorrelation(const std::vector<double>& a, const std::vector<double>& b);
+
+// 代理筛选统计
+struct SurrogateStats {
+    long long candidates = 0;   // 参与代理评分的交叉候选数
+    long long decoded = 0;      // 实际解码并评估的候选数
+    long long audits = 0;       // 全量评估以核对排序的次数
+    double spearman_sum = 0.0;  // 各次核对的秩相关之和
+    double score_ms = 0.0;      // 代理评分累计耗时
+    long long disabled_at = -1; // 平均秩相关 <= 0 时关闭筛选所在的代数，-1 表示未关闭
+};
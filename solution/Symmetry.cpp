@@ -0,0 +1,59 @@
+#include "Symmetry.h"
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+void CanonicalizeCards(std::vector<std::pair<int,int>>& order, int card_num)
+{
+    std::vector<int> label(card_num, -1);
+    int next = 0;
+    for (auto& p : order) {
+        int& l = label[p.second];
+        if (l < 0) l = next++;
+        p.second = l;
+    }
+}
+
+std::vector<int> AlignCards(const RowView& ref,
+                            const RowView& indiv,
+                            int card_num)
+{
+    int max_id = -1;
+    for (size_t i = 0; i < ref.size(); ++i) max_id = std::max(max_id, ref[i].first);
+    std::vector<int> ref_card(max_id + 1, -1);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        const auto p = ref[i];
+        ref_card[p.first] = p.second;
+    }
+
+    // co[a * card_num + b]：indiv 在卡 a、ref 在卡 b 的节点数
+    std::vector<int> co(static_cast<size_t>(card_num) * card_num, 0);
+    for (size_t i = 0; i < indiv.size(); ++i) {
+        const auto p = indiv[i];
+        if (p.first > max_id || ref_card[p.first] < 0) continue;
+        ++co[p.second * card_num + ref_card[p.first]];
+    }
+    std::vector<std::tuple<int,int,int>> pairs; // (共现数, indiv 卡, ref 卡)
+    for (int a = 0; a < card_num; ++a) {
+        for (int b = 0; b < card_num; ++b) {
+            if (co[a * card_num + b] > 0) pairs.emplace_back(co[a * card_num + b], a, b);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), std::greater<std::tuple<int,int,int>>());
+    std::vector<int> perm(card_num, -1);
+    std::vector<char> used(card_num, 0);
+    for (const auto& t : pairs) {
+        int a = std::get<1>(t), b = std::get<2>(t);
+        if (perm[a] >= 0 || used[b]) continue;
+        perm[a] = b;
+        used[b] = 1;
+    }
+    for (int a = 0, b = 0; a < card_num; ++a) {
+        if (perm[a] >= 0) continue;
+        while (used[b]) ++b;
+        perm[a] = b;
+        used[b] = 1;
+    }
+    return perm;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "Population.h"
+
+// 卡对称：所有卡完全相同，仅卡号置换不同的两个调度 makespan 相同
+
+// 规范化卡号：按执行序中首次使用的先后把卡重新编号为 0,1,2,...（原地修改），
+// 卡号置换等价的调度得到相同的表示
+void CanonicalizeCards(std::vector<std::pair<int,int>>& order, int card_num);
+
+// 卡号对齐：求置换 perm[indiv 的卡] = ref 的卡，使同一节点在两者中卡号一致的数目尽量多
+// （按共现次数降序贪心匹配，未匹配的卡按编号补齐）；节点 id 需连续，两者均为基因池行的只读视图
+std::vector<int> AlignCards(const RowView& ref,
+                            const RowView& indiv,
+                            int card_num);
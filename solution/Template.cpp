@@ -0,0 +1,360 @@
+#include "Template.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <random>
+#include <tuple>
+#include "Components.h"
+#include "DSC.h"
+#include "GAInit.h"
+#include "Insertion.h"
+#include "Simulator.h"
+
+namespace {
+
+using Color = unsigned long long;
+
+const int kColorRounds = 3;      // WL 迭代轮数：颜色只反映 3 跳以内的局部结构
+const int kMinPatternSize = 4;   // 模板种子使用的实例节点数下限
+
+Color Mix(Color h, Color x) {
+    // splitmix64 终混
+    x += 0x9e3779b97f4a7c15ULL + h * 31;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+std::vector<Color> NodeColors(const std::vector<const Node*>& nodes,
+                              const std::vector<std::vector<int>>& consumers) {
+    const int n = static_cast<int>(nodes.size());
+    std::vector<Color> color(n, 0), next(n, 0);
+    for (int v = 0; v < n; ++v) {
+        if (!nodes[v]) continue;
+        Color h = Mix(0, static_cast<Color>(nodes[v]->exec_time()));
+        h = Mix(h, static_cast<Color>(nodes[v]->transfer_time()));
+        h = Mix(h, nodes[v]->inputs().size());
+        color[v] = Mix(h, consumers[v].size());
+    }
+    std::vector<Color> buf;
+    for (int r = 0; r < kColorRounds; ++r) {
+        for (int v = 0; v < n; ++v) {
+            if (!nodes[v]) continue;
+            buf.clear();
+            for (const Node* p : nodes[v]->inputs()) if (p) buf.push_back(color[p->id()]);
+            std::sort(buf.begin(), buf.end());
+            Color h = Mix(color[v], 1);
+            for (Color c : buf) h = Mix(h, c);
+            buf.clear();
+            for (int s : consumers[v]) buf.push_back(color[s]);
+            std::sort(buf.begin(), buf.end());
+            h = Mix(h, 2);
+            for (Color c : buf) h = Mix(h, c);
+            next[v] = h;
+        }
+        color.swap(next);
+    }
+    return color;
+}
+
+// 从各锚点按位置同步扩张：位置 p 的每个方向（输入 / 消费者）上，以实例 0 的未占用邻居（按颜色排序）为准，
+// 其余实例依次取同色的下一个未占用邻居，全部找到才加入新位置。实例过小时撤销占用并返回空
+std::vector<std::vector<int>> GrowInstances(
+        const std::vector<int>& anchors,
+        const std::vector<const Node*>& nodes,
+        const std::vector<std::vector<int>>& consumers,
+        const std::vector<Color>& color,
+        int min_size,
+        std::vector<char>& claimed)
+{
+    const int k = static_cast<int>(anchors.size());
+    std::vector<std::vector<int>> inst(k);
+    for (int i = 0; i < k; ++i) {
+        inst[i].push_back(anchors[i]);
+        claimed[anchors[i]] = 1;
+    }
+    std::vector<std::vector<std::pair<Color,int>>> cand(k);
+    std::vector<size_t> cursor(k);
+    std::vector<int> picked(k);
+    for (size_t p = 0; p < inst[0].size(); ++p) {
+        for (int dir = 0; dir < 2; ++dir) {
+            for (int i = 0; i < k; ++i) {
+                cand[i].clear();
+                int x = inst[i][p];
+                if (dir == 0) {
+                    for (const Node* q : nodes[x]->inputs()) {
+                        if (q && !claimed[q->id()]) cand[i].push_back({color[q->id()], static_cast<int>(q->id())});
+                    }
+                } else {
+                    for (int y : consumers[x]) if (!claimed[y]) cand[i].push_back({color[y], y});
+                }
+                std::sort(cand[i].begin(), cand[i].end());
+                cand[i].erase(std::unique(cand[i].begin(), cand[i].end()), cand[i].end());
+            }
+            std::fill(cursor.begin(), cursor.end(), 0);
+            for (const auto& c0 : cand[0]) {
+                if (claimed[c0.second]) continue;
+                picked[0] = c0.second;
+                claimed[c0.second] = 1;
+                int i = 1;
+                for (; i < k; ++i) {
+                    const auto& ci = cand[i];
+                    size_t& cur = cursor[i];
+                    while (cur < ci.size() && (ci[cur].first < c0.first || claimed[ci[cur].second])) ++cur;
+                    if (cur == ci.size() || ci[cur].first != c0.first) break;
+                    picked[i] = ci[cur++].second;
+                    claimed[picked[i]] = 1;
+                }
+                if (i < k) {
+                    for (int j = 0; j < i; ++j) claimed[picked[j]] = 0;
+                    continue;
+                }
+                for (int j = 0; j < k; ++j) inst[j].push_back(picked[j]);
+            }
+        }
+    }
+    if (static_cast<int>(inst[0].size()) < min_size) {
+        for (const auto& one : inst) for (int x : one) claimed[x] = 0;
+        return {};
+    }
+    return inst;
+}
+
+} // namespace
+
+std::vector<RepeatedPattern> FindRepeatedSubgraphs(const std::vector<const Node*>& nodes, int min_size)
+{
+    const int n = static_cast<int>(nodes.size());
+    std::vector<std::vector<int>> consumers(n);
+    for (const Node* v : nodes) {
+        if (!v) continue;
+        for (const Node* p : v->inputs()) if (p) consumers[p->id()].push_back(static_cast<int>(v->id()));
+    }
+    std::vector<Color> color = NodeColors(nodes, consumers);
+
+    std::unordered_map<Color, std::vector<int>> classes;
+    for (int v = 0; v < n; ++v) if (nodes[v]) classes[color[v]].push_back(v);
+    // 主重复次数：同色类大小中覆盖节点最多的一个
+    std::unordered_map<size_t, size_t> cover;
+    for (const auto& kv : classes) if (kv.second.size() >= 2) cover[kv.second.size()] += kv.second.size();
+    size_t main_k = 0;
+    for (const auto& kv : cover) {
+        if (main_k == 0 || kv.second > cover[main_k] || (kv.second == cover[main_k] && kv.first < main_k)) main_k = kv.first;
+    }
+    std::vector<const std::vector<int>*> order;
+    for (const auto& kv : classes) if (kv.second.size() >= 2) order.push_back(&kv.second);
+    // 主重复次数的类优先；其余类越小实例越大，排在前面
+    std::sort(order.begin(), order.end(), [&](const std::vector<int>* a, const std::vector<int>* b) {
+        bool ma = a->size() == main_k, mb = b->size() == main_k;
+        if (ma != mb) return ma;
+        if (a->size() != b->size()) return a->size() < b->size();
+        return a->front() < b->front();
+    });
+
+    std::vector<RepeatedPattern> patterns;
+    std::vector<char> claimed(n, 0);
+    std::vector<int> anchors;
+    for (const auto* cls : order) {
+        anchors.clear();
+        for (int v : *cls) if (!claimed[v]) anchors.push_back(v);
+        if (anchors.size() < 2) continue;
+        auto inst = GrowInstances(anchors, nodes, consumers, color, min_size, claimed);
+        if (!inst.empty()) patterns.push_back({std::move(inst)});
+    }
+    std::stable_sort(patterns.begin(), patterns.end(), [](const RepeatedPattern& a, const RepeatedPattern& b) {
+        return a.instances.size() * a.instances[0].size() > b.instances.size() * b.instances[0].size();
+    });
+    return patterns;
+}
+
+std::vector<std::pair<int,int>> BuildTemplateIndividual(
+        const std::unordered_map<int,int>& indeg0,
+        const std::unordered_map<int,std::vector<int>>& adj,
+        const std::unordered_map<int, const Node*>& id2node,
+        int card_num)
+{
+    if (card_num <= 0) return {};
+    std::vector<const Node*> nodes = DenseNodes(id2node);
+    const int m = static_cast<int>(nodes.size());
+    std::vector<RepeatedPattern> patterns = FindRepeatedSubgraphs(nodes, kMinPatternSize);
+    if (patterns.empty()) return {};
+
+    // 无通信 top-level，作为实例偏移与未覆盖节点的优先级
+    std::vector<long long> tl(m, 0);
+    {
+        std::unordered_map<int,int> indeg = indeg0;
+        std::queue<int> q;
+        for (const auto& kv : indeg) if (kv.second == 0) q.push(kv.first);
+        while (!q.empty()) {
+            int v = q.front();
+            q.pop();
+            auto it = adj.find(v);
+            if (it == adj.end()) continue;
+            for (int s : it->second) {
+                tl[s] = std::max(tl[s], tl[v] + nodes[v]->exec_time());
+                if (--indeg[s] == 0) q.push(s);
+            }
+        }
+    }
+
+    std::unordered_map<int,double> prio;
+    std::unordered_map<int,int> plain_cards, shifted_cards;
+    std::vector<std::pair<long long, const std::vector<int>*>> stamped; // (实例偏移, 实例节点)
+    prio.reserve(indeg0.size());
+    for (const auto& pat : patterns) {
+        const auto& inst = pat.instances;
+        const int k = static_cast<int>(inst.size());
+        const int size = static_cast<int>(inst[0].size());
+
+        // 只调度第一个实例：局部 id 即模式位置
+        ContractedGraph sub = InducedSubgraph(nodes, inst[0]);
+        std::unordered_map<int, const Node*> sub_id2node;
+        std::unordered_map<int,int> sub_indeg;
+        std::unordered_map<int,std::vector<int>> sub_adj;
+        for (const Node* v : sub.nodes) {
+            int id = static_cast<int>(v->id());
+            sub_id2node[id] = v;
+            sub_indeg[id] = static_cast<int>(v->inputs().size());
+            for (const Node* p : v->inputs()) sub_adj[static_cast<int>(p->id())].push_back(id);
+        }
+        std::vector<const Node*> sub_nodes(sub.nodes.begin(), sub.nodes.end());
+        auto rank_u = ComputeUpwardRank(sub_indeg, sub_adj, sub_id2node);
+        auto local = BuildInsertionIndividual(sub_indeg, sub_adj, sub_id2node, rank_u, card_num, nullptr);
+        auto dsc = BuildDSCIndividual(sub_indeg, sub_adj, sub_id2node, card_num);
+        if (local.empty() || (!dsc.empty() && SimulateOrder(dsc, sub_nodes, card_num) < SimulateOrder(local, sub_nodes, card_num))) {
+            local.swap(dsc);
+        }
+        if (local.empty()) continue;
+
+        // 回放模板得到各位置的开始时间与卡号
+        SimState st;
+        st.Reset(card_num, size);
+        std::vector<long long> start(size, 0);
+        std::vector<int> card(size, 0);
+        long long span = 0;
+        for (const auto& pc : local) {
+            long long end = st.Commit(sub_nodes[pc.first], pc.second);
+            start[pc.first] = end - sub_nodes[pc.first]->exec_time();
+            card[pc.first] = pc.second;
+            span = std::max(span, end);
+        }
+
+        // 实例偏移取其节点的最早 top-level；并发排名 = 排在前面且在本实例开始时仍未结束的实例数
+        std::vector<long long> offset(k, 0);
+        for (int i = 0; i < k; ++i) {
+            offset[i] = tl[inst[i][0]];
+            for (int x : inst[i]) offset[i] = std::min(offset[i], tl[x]);
+        }
+        std::vector<int> by_offset(k);
+        for (int i = 0; i < k; ++i) by_offset[i] = i;
+        std::stable_sort(by_offset.begin(), by_offset.end(), [&](int a, int b){ return offset[a] < offset[b]; });
+        std::vector<int> rank(k, 0);
+        int max_rank = 0;
+        for (int a = 0; a < k; ++a) {
+            for (int b = a - 1; b >= 0; --b) {
+                if (offset[by_offset[b]] + span > offset[by_offset[a]]) ++rank[by_offset[a]];
+            }
+            max_rank = std::max(max_rank, rank[by_offset[a]]);
+        }
+        const int stride = std::max(1, card_num / (max_rank + 1));
+
+        for (int i = 0; i < k; ++i) {
+            stamped.emplace_back(offset[i], &inst[i]);
+            for (int p = 0; p < size; ++p) {
+                int x = inst[i][p];
+                prio[x] = static_cast<double>(offset[i] + start[p]);
+                plain_cards[x] = card[p];
+                shifted_cards[x] = (card[p] + rank[i] * stride) % card_num;
+            }
+        }
+    }
+    if (plain_cards.empty()) return {};
+    for (const auto& kv : indeg0) {
+        if (!prio.count(kv.first)) prio[kv.first] = static_cast<double>(tl[kv.first]);
+    }
+
+    // 边界对齐：按偏移依次为每个实例选择本地卡到全局卡的映射。按边界输入的 transfer 权重贪心匹配，
+    // 使来自已盖印实例的输入数据尽量已驻留在目标卡上；只匹配在该本地卡首个节点开始前已空闲的全局卡，
+    // 其余本地卡优先保持原编号，否则放到最早空闲的卡
+    std::unordered_map<int,int> aligned_cards;
+    aligned_cards.reserve(plain_cards.size());
+    std::stable_sort(stamped.begin(), stamped.end(),
+        [](const std::pair<long long, const std::vector<int>*>& a, const std::pair<long long, const std::vector<int>*>& b) {
+            return a.first < b.first;
+        });
+    std::vector<std::tuple<long long,int,int>> weights; // (权重, 本地卡, 全局卡)
+    std::vector<long long> w(static_cast<size_t>(card_num) * card_num);
+    std::vector<long long> card_free(card_num, 0), first(card_num), last(card_num);
+    std::vector<int> local_to_global(card_num), global_used(card_num);
+    for (const auto& sp : stamped) {
+        std::fill(w.begin(), w.end(), 0);
+        std::fill(first.begin(), first.end(), -1);
+        std::fill(last.begin(), last.end(), -1);
+        for (int x : *sp.second) {
+            int a = plain_cards[x];
+            long long s0 = static_cast<long long>(prio[x]);
+            if (first[a] < 0 || s0 < first[a]) first[a] = s0;
+            last[a] = std::max(last[a], s0 + nodes[x]->exec_time());
+            for (const Node* p : nodes[x]->inputs()) {
+                auto it = p ? aligned_cards.find(static_cast<int>(p->id())) : aligned_cards.end();
+                if (it != aligned_cards.end()) w[a * card_num + it->second] += p->transfer_time();
+            }
+        }
+        weights.clear();
+        for (int a = 0; a < card_num; ++a) {
+            for (int b = 0; b < card_num; ++b) {
+                if (w[a * card_num + b] > 0 && card_free[b] <= first[a]) weights.emplace_back(w[a * card_num + b], a, b);
+            }
+        }
+        std::sort(weights.begin(), weights.end(), std::greater<std::tuple<long long,int,int>>());
+        std::fill(local_to_global.begin(), local_to_global.end(), -1);
+        std::fill(global_used.begin(), global_used.end(), 0);
+        for (const auto& t : weights) {
+            int a = std::get<1>(t), b = std::get<2>(t);
+            if (local_to_global[a] >= 0 || global_used[b]) continue;
+            local_to_global[a] = b;
+            global_used[b] = 1;
+        }
+        for (int a = 0; a < card_num; ++a) {
+            if (local_to_global[a] >= 0 || first[a] < 0) continue;
+            int b = a;
+            if (global_used[b] || card_free[b] > first[a]) {
+                b = -1;
+                for (int c = 0; c < card_num; ++c) {
+                    if (!global_used[c] && (b < 0 || card_free[c] < card_free[b])) b = c;
+                }
+            }
+            local_to_global[a] = b;
+            global_used[b] = 1;
+        }
+        for (int a = 0; a < card_num; ++a) {
+            if (first[a] >= 0) card_free[local_to_global[a]] = std::max(card_free[local_to_global[a]], last[a]);
+        }
+        for (int x : *sp.second) aligned_cards[x] = local_to_global[plain_cards[x]];
+    }
+
+    // 盖印后的卡号保持不变，未覆盖节点按 EFT 重选
+    CounterRng rng(0);
+    auto stamp = [&](const std::unordered_map<int,int>& cards) {
+        auto order = TopoByPriority(indeg0, adj, card_num, rng, prio, &cards);
+        std::vector<int> free_pos;
+        for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+            if (!cards.count(order[i].first)) free_pos.push_back(i);
+        }
+        return free_pos.empty() ? order : RefineCardsAt(order, id2node, card_num, free_pos);
+    };
+    std::vector<std::vector<std::pair<int,int>>> cands;
+    cands.push_back(stamp(aligned_cards));
+    cands.push_back(stamp(shifted_cards));
+    cands.push_back(TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, prio, &plain_cards));
+
+    std::vector<std::pair<int,int>> best;
+    long long best_fit = -1;
+    for (auto& c : cands) {
+        if (c.empty()) continue;
+        long long fit = SimulateOrder(c, nodes, card_num);
+        if (best_fit < 0 || fit < best_fit) { best_fit = fit; best.swap(c); }
+    }
+    return best;
+}
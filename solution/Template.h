@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "node.h"
+
+// 重复子图：instances[i][p] 为第 i 个实例中模式位置 p 的节点 id。
+// 各实例按位置一一对应，对应节点的 exec_time、transfer_time 与邻接结构相同
+struct RepeatedPattern {
+    std::vector<std::vector<int>> instances;
+};
+
+// 检测重复子图：先用 WL 式迭代哈希给节点着色（初值为 exec/transfer/出入度，每轮并入排序后的输入与消费者颜色），
+// 同色类中的节点作为各实例的锚点，按位置同步 BFS 扩张：所有实例都能找到同色且未被占用的邻居时才扩张该位置。
+// 优先处理覆盖节点最多的类大小（即主重复次数），节点数不足 min_size 的实例组丢弃。
+// nodes 为按 id 下标的稠密节点表（可含空位），返回按覆盖节点数降序的模式
+std::vector<RepeatedPattern> FindRepeatedSubgraphs(const std::vector<const Node*>& nodes, int min_size);
+
+// 模板种子：每个重复模式只调度第一个实例（插入式 HEFT 与 DSC 取优），
+// 其相对开始时间与卡号盖印到其余实例（实例偏移取其最早的无通信 top-level）；
+// 卡号分别按边界对齐映射、按并发实例错开平移和 EFT 重选三种方式展开，未被覆盖的节点按 EFT 选卡，返回模拟最优者。
+// 没有重复模式时返回空
+std::vector<std::pair<int,int>> BuildTemplateIndividual(
+    const std::unordered_map<int,int>& indeg0,
+    const std::unordered_map<int,std::vector<int>>& adj,
+    const std::unordered_map<int, const Node*>& id2node,
+    int card_num);
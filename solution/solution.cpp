@@ -5,21 +5,45 @@
 #include <random>
 #include <chrono>
 #include <numeric>
+#include <iostream>
+#include <limits>
+#include <atomic>
+#include <thread>
 #include "GAConfig.h"
 #include "GAInit.h"
+#include "LNS.h"
+#include "Justify.h"
+#include "CriticalPath.h"
+#include "Crossover.h"
+#include "PathRelink.h"
+#include "Population.h"
+#include "Bandit.h"
+#include "BeamSearch.h"
+#include "Components.h"
+#include "ConfigIO.h"
+#include "Contract.h"
+#include "Deadline.h"
+#include "FitnessCache.h"
+#include "GraphFeatures.h"
+#include "Insertion.h"
+#include "Multilevel.h"
+#include "Simulator.h"
+#include "Stats.h"
+#include "Strategy.h"
+#include "Surrogate.h"
+#include "Symmetry.h"
 
-std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all_nodes, int card_num) {
-    if (card_num <= 0) return {};
+namespace {
 
-    // 建图：id 映射、入度与邻接
-    std::unordered_map<int, const Node*> id2node;
+// 建图：id 映射、入度与邻接
+void BuildGraph(const std::vector<Node*>& all_nodes,
+                std::unordered_map<int, const Node*>& id2node,
+                std::unordered_map<int, int>& indeg0,
+                std::unordered_map<int, std::vector<int>>& adj) {
     id2node.reserve(all_nodes.size());
     for (const Node* n : all_nodes) {
         if (n) id2node[n->id()] = n;
     }
-
-    std::unordered_map<int, int> indeg0;
-    std::unordered_map<int, std::vector<int>> adj;
     for (const Node* n : all_nodes) {
         if (!n) continue;
         int id = n->id();
@@ -31,6 +55,33 @@ std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all
             }
         }
     }
+}
+
+// 固定工作量模式下的名义预算（约 11 天），只为让所有截止时间都不触发
+constexpr long long kFixedWorkBudgetMs = 1000000000LL;
+
+// 随机数流：种子（<0 取时间）下按 rng_stream 与求解阶段 stage 各派生一条
+CounterRng MakeRng(const GAConfig& cfg, uint64_t stage) {
+    uint64_t seed = (cfg.seed >= 0) ? static_cast<uint64_t>(cfg.seed)
+                                    : static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    return CounterRng(seed).Fork(static_cast<uint64_t>(cfg.rng_stream)).Fork(stage);
+}
+
+// 固定工作量模式下各 LNS 调用的窗口上限（0 表示只受截止时间约束）
+long long LnsWindowLimit(const GAConfig& cfg) {
+    return cfg.fixed_work ? cfg.lns_fixed_windows : 0;
+}
+
+// 在给定图上运行完整流程（种子、GA、LNS），节点 id 需连续；t_start 起 time_budget_ms 内结束
+std::vector<std::pair<size_t,size_t>> SolveSchedule(const std::vector<Node*>& all_nodes, int card_num,
+                                                    const GAConfig& cfg,
+                                                    std::chrono::high_resolution_clock::time_point t_start,
+                                                    long long time_budget_ms,
+                                                    SolveStats* stats) {
+    std::unordered_map<int, const Node*> id2node;
+    std::unordered_map<int, int> indeg0;
+    std::unordered_map<int, std::vector<int>> adj;
+    BuildGraph(all_nodes, id2node, indeg0, adj);
 
     // 节点列表
     std::vector<int> node_ids;
@@ -39,63 +90,152 @@ std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all
 
     if (node_ids.empty()) return {};
 
-    // 使用内置默认配置，不读取本地文件
-    GAConfig cfg;
-    std::mt19937 rng(static_cast<unsigned int>(
-        (cfg.seed >= 0) ? cfg.seed : std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+    CounterRng rng = MakeRng(cfg, 0);
+    SolveStats st; // 本次求解的热路径统计，结束时并入 *stats
 
-    // 时间预算：50,000 点 ≈ 1 分钟，按点数线性缩放
-    // 从进入 ExecuteOrder 开始计时；达到目标时间（按 50000 节点≈60秒）则早停，单位毫秒
-    auto t_start = std::chrono::high_resolution_clock::now();
-    long long time_budget_ms = static_cast<long long>(60000.0 * (static_cast<double>(node_ids.size()) / 50000.0));
+    // GA 与 LNS 分摊时间预算，LNS 使用尾部 lns_time_share 部分
+    long long lns_budget_ms = cfg.lns_enabled ? static_cast<long long>(time_budget_ms * cfg.lns_time_share) : 0;
+    long long ga_budget_ms = time_budget_ms - lns_budget_ms;
+    const auto ga_deadline = t_start + std::chrono::milliseconds(ga_budget_ms);
 
     // 拓扑排序与卡分配改为调用独立实现
 
     // 复用转换缓冲，避免每次评估都分配新向量
     std::vector<std::pair<size_t,size_t>> order_buf;
     order_buf.reserve(node_ids.size());
+    long long evals = 0;
     auto evaluate = [&](const std::vector<std::pair<int,int>>& orderInt) {
+        ++evals;
         order_buf.resize(orderInt.size());
         for (size_t i = 0; i < orderInt.size(); ++i) {
             order_buf[i] = { static_cast<size_t>(orderInt[i].first), static_cast<size_t>(orderInt[i].second) };
         }
+        EO_STAT(++st.duration_calls);
+        EO_STAT_TIMER(&st.duration_ms);
         return CalcTotalDuration(order_buf, all_nodes, static_cast<size_t>(card_num));
     };
+    // 适应度缓存：任何代中出现过的调度（规范卡号下）直接复用 makespan，跳过模拟
+    FitnessCache fit_cache(static_cast<size_t>(std::max(0, cfg.fitness_cache_size)));
+    auto evaluate_cached = [&](const std::vector<std::pair<int,int>>& orderInt) {
+        EO_STAT(++st.evaluations);
+        uint64_t key = ScheduleHash(orderInt);
+        long long fit;
+        if (fit_cache.Find(key, &fit)) {
+            EO_STAT(++st.cache_hits);
+            return fit;
+        }
+        fit = evaluate(orderInt);
+        fit_cache.Insert(key, fit);
+        return fit;
+    };
 
-    // GA 参数来自配置（不再使用轮次，仅保留时间退出）
+    // GA 参数来自配置（轮次上限仅在固定工作量模式下使用）
     const int pop_size = cfg.pop_size;
     const double mutation_rate = cfg.mutation_rate;
     const int tournament_k = cfg.tournament_k;
     // 预分配下一代与适应度缓冲，减少每轮内部分配
-    std::vector<std::vector<std::pair<int,int>>> next;
-    next.reserve(pop_size);
+    std::vector<int> next_rows;
+    next_rows.reserve(pop_size);
     std::vector<long long> fitness_next;
     fitness_next.reserve(pop_size);
-    auto schedule_equal = [](const std::vector<std::pair<int,int>>& a,
-                             const std::vector<std::pair<int,int>>& b) {
-        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    // 卡号规范化：卡号置换等价的个体表示相同，去重比较与交叉都在规范卡号上进行
+    auto canonicalize = [&](std::vector<std::pair<int,int>>& indiv) {
+        if (cfg.canonical_cards) CanonicalizeCards(indiv, card_num);
     };
 
     // 初始种群从独立文件生成（启发式优先级 + 少量随机扰动）
-    auto population = InitializePopulation(node_ids, indeg0, adj, id2node, card_num, pop_size, rng);
-    if (population.empty()) return {};
+    std::vector<SeedReport> seed_report;
+    const PriorityWeights prio_weights = {cfg.prio_w_exec, cfg.prio_w_transfer, cfg.prio_w_up_rank,
+                                          cfg.prio_w_down_rank, cfg.prio_w_out_degree, cfg.prio_w_slack};
+    auto t_seeds = std::chrono::high_resolution_clock::now();
+    auto seeds = InitializePopulation(node_ids, indeg0, adj, id2node, card_num, pop_size, cfg.greedy_seed, cfg.partition_seed, prio_weights,
+                                      ga_deadline, rng,
+                                      cfg.verbose ? &seed_report : nullptr);
+    if (seeds.empty()) return {};
+    const auto t_seeds_done = std::chrono::high_resolution_clock::now();
+    const size_t seed_num = seeds.size();
+    for (auto& indiv : seeds) canonicalize(indiv);
+    if (cfg.verbose) {
+        std::cerr << "[Seeds]";
+        for (const auto& r : seed_report) std::cerr << " " << r.name << "=" << r.makespan << "(" << r.build_ms << "ms)";
+        std::cerr << std::endl;
+    }
 
     // 适应度缓存：减少对 CalcTotalDuration 的重复调用
-    std::vector<long long> fitness(population.size());
-    for (size_t i = 0; i < population.size(); ++i) {
-        fitness[i] = evaluate(population[i]);
+    std::vector<long long> fitness(seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        fitness[i] = evaluate_cached(seeds[i]);
+    }
+    // 束搜索解码器：作为额外强种子替换最差个体
+    if (cfg.beam_width > 0) {
+        auto t_beam = std::chrono::high_resolution_clock::now();
+        auto rank_u = ComputeUpwardRank(indeg0, adj, id2node);
+        // 束搜索最多占用剩余 GA 时间的 beam_time_share，超时放弃
+        auto beam_deadline = t_beam + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                                          (ga_deadline - t_beam) * cfg.beam_time_share);
+        auto beam = BeamSearchSchedule(indeg0, adj, id2node, rank_u, card_num, cfg.beam_width, cfg.beam_expand,
+                                       beam_deadline);
+        if (!beam.empty()) {
+            canonicalize(beam);
+            long long beam_fit = evaluate_cached(beam);
+            int worst = static_cast<int>(std::max_element(fitness.begin(), fitness.end()) - fitness.begin());
+            if (cfg.verbose) {
+                std::cerr << "[Beam] width=" << cfg.beam_width << " expand=" << cfg.beam_expand
+                          << " makespan=" << beam_fit
+                          << " time_ms=" << std::chrono::duration<double, std::milli>(
+                                 std::chrono::high_resolution_clock::now() - t_beam).count()
+                          << " population_best=" << *std::min_element(fitness.begin(), fitness.end())
+                          << std::endl;
+            }
+            if (beam_fit < fitness[worst]) {
+                seeds[worst] = std::move(beam);
+                fitness[worst] = beam_fit;
+            }
+        }
+    }
+
+    // 种群存入基因池：当前代占 pop_rows 中的行，下一代的子代写入其余空闲行
+    const int gene_num = static_cast<int>(seeds[0].size());
+    PopulationArena arena(static_cast<int>(std::max<size_t>(seeds.size(), pop_size)) + pop_size, gene_num);
+    std::vector<int> pop_rows(seeds.size());
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        pop_rows[i] = static_cast<int>(i);
+        arena.Store(pop_rows[i], seeds[i]);
+    }
+    std::vector<std::vector<std::pair<int,int>>>().swap(seeds);
+    std::vector<char> row_used(arena.rows(), 0);
+    // 算子的暂存缓冲（父代 A/B、子代），跨代复用
+    std::vector<std::pair<int,int>> buf_a, buf_b;
+    // 是否已做过前向-后向改进（与 pop_rows 对齐）
+    std::vector<char> justified(pop_rows.size(), 0), justified_next;
+    justified_next.reserve(pop_size);
+    JustifyStats fbj_stats;
+    // 初始精英（前两名）同样先做前向-后向改进（种子已用完 GA 时间时跳过）
+    if (cfg.fbj_enabled && std::chrono::high_resolution_clock::now() < ga_deadline) {
+        EO_STAT_TIMER(&st.refine_ms);
+        std::vector<int> order_idx(pop_rows.size());
+        std::iota(order_idx.begin(), order_idx.end(), 0);
+        std::sort(order_idx.begin(), order_idx.end(), [&](int a, int b){ return fitness[a] < fitness[b]; });
+        for (size_t e = 0; e < order_idx.size() && e < 2; ++e) {
+            int i = order_idx[e];
+            arena.Load(pop_rows[i], buf_a);
+            fitness[i] = ForwardBackwardImprove(buf_a, fitness[i], id2node, adj,
+                                                card_num, cfg.fbj_max_iters, &fbj_stats);
+            canonicalize(buf_a);
+            fit_cache.Insert(ScheduleHash(buf_a), fitness[i]);
+            arena.Store(pop_rows[i], buf_a);
+            justified[i] = 1;
+        }
     }
     int best_idx = static_cast<int>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
-    auto best = population[best_idx];
+    std::vector<std::pair<int,int>> best;
+    arena.Load(pop_rows[best_idx], best);
     long long best_fit = fitness[best_idx];
-    // 设定目标时间为初始贪心解的结束时间，并要求达到其 90%
-    long long target_time = fitness[0];
-    long long required_time = static_cast<long long>(target_time * 0.9);
 
     // 锦标赛选择返回索引，使用缓存适应度比较
-    auto tournament_select_idx = [&](const std::vector<std::vector<std::pair<int,int>>>& pop,
+    auto tournament_select_idx = [&](const std::vector<int>& rows,
                                      const std::vector<long long>& fit) {
-        std::uniform_int_distribution<int> idx_dist(0, static_cast<int>(pop.size()) - 1);
+        std::uniform_int_distribution<int> idx_dist(0, static_cast<int>(rows.size()) - 1);
         int winner = idx_dist(rng);
         long long winner_fit = fit[winner];
         for (int i = 1; i < tournament_k; ++i) {
@@ -105,34 +245,104 @@ std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all
         return winner;
     };
 
-    auto crossover = [&](const std::vector<std::pair<int,int>>& A,
-                        const std::vector<std::pair<int,int>>& B) -> std::vector<std::pair<int,int>> {
-        if (A.empty() || B.empty() || A.size() != B.size()) return {};
-        // 基于位置平均的优先级，然后依优先级做拓扑排序；卡继承自对应父代（随机选）
+    // 优先级平均交叉分两步：先构造基因型（位置平均优先级 + 继承卡），再做 EFT 解码，
+    // 代理筛选在两步之间进行，被淘汰的候选不解码；稠密数组上的保序交叉直接得到子代执行序
+    struct Offspring {
+        int parent_a;
+        int parent_b;
         std::unordered_map<int, double> prio;
+        std::unordered_map<int, int> inherit_cards;
+        std::vector<std::pair<int,int>> child;
+        long long score;
+        CounterRng stream; // 该候选专属的随机数流：构造、评分、解码各派生一条子流
+        int xo_arm;    // 所用交叉算子（CrossoverOp 下标）
+        double xo_ms;  // 构造、代理评分与解码的累计耗时
+    };
+    // 自适应算子选择：交叉与变异各一个老虎机，按 改进量/毫秒 分配信用
+    enum MutationArm { kMutNone, kMutCriticalPath, kMutNoise, kMutCardRefine, kMutArms };
+    OperatorBandit xo_bandit({"priority_eft", "ppx", "two_point", "card_uniform"}, cfg.bandit_decay, cfg.bandit_explore);
+    // 固定工作量模式下按调用次数计成本，避免计时抖动影响算子选择
+    auto bandit_cost = [&](double ms) { return cfg.fixed_work ? 1.0 : ms; };
+    OperatorBandit mut_bandit({"none", "critical_path", "noise_rebuild", "card_refine"}, cfg.bandit_decay, cfg.bandit_explore);
+    CrossoverWorkspace xo_ws;
+    std::uniform_int_distribution<int> xo_pick(0, static_cast<int>(CrossoverOp::kMix) - 1);
+    auto make_offspring = [&](int pa, int pb, Offspring& off) -> bool {
+        EO_STAT_TIMER(&st.crossover_ms);
+        auto t_make = std::chrono::high_resolution_clock::now();
+        CrossoverOp op = cfg.crossover_op;
+        if (cfg.bandit_enabled) op = static_cast<CrossoverOp>(xo_bandit.Select());
+        if (op == CrossoverOp::kMix) op = static_cast<CrossoverOp>(xo_pick(rng));
+        off.xo_arm = static_cast<int>(op);
+        struct MakeTimer {
+            std::chrono::high_resolution_clock::time_point t0;
+            double* ms;
+            ~MakeTimer() { *ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t0).count(); }
+        } make_timer{t_make, &off.xo_ms};
+        // 父代直接以只读视图读取基因池行，不拷贝
+        const RowView A = arena.Row(pop_rows[pa]);
+        const RowView B = arena.Row(pop_rows[pb]);
+        off.parent_a = pa;
+        off.parent_b = pb;
+        off.prio.clear();
+        off.inherit_cards.clear();
+        off.child.clear();
+        if (A.empty() || B.empty() || A.size() != B.size()) return false;
+
+        // B 的卡号先按与 A 的共现对齐，避免混合两套不相容的卡号
+        std::vector<int> perm(card_num);
+        if (cfg.canonical_cards) {
+            perm = AlignCards(A, B, card_num);
+        } else {
+            std::iota(perm.begin(), perm.end(), 0);
+        }
+        switch (op) {
+        case CrossoverOp::kPPX:
+            PrecedencePreservingCrossover(A, B, perm, rng, xo_ws, off.child);
+            return true;
+        case CrossoverOp::kTwoPoint:
+            TwoPointOrderCrossover(A, B, perm, rng, xo_ws, off.child);
+            return true;
+        case CrossoverOp::kCardUniform:
+            CardUniformCrossover(A, B, perm, rng, xo_ws, off.child);
+            return true;
+        default:
+            break;
+        }
+
+        // 基于位置平均的优先级，然后依优先级做拓扑排序；卡继承自对应父代（随机选）
+        auto& prio = off.prio;
         for (size_t i = 0; i < A.size(); ++i) prio[A[i].first] += static_cast<double>(i);
         for (size_t i = 0; i < B.size(); ++i) prio[B[i].first] += static_cast<double>(i);
         for (auto& kv : prio) kv.second /= 2.0; // 平均位置
-
-        std::unordered_map<int,int> inherit_cards;
+        auto& inherit_cards = off.inherit_cards;
         std::uniform_int_distribution<int> coin(0,1);
         for (size_t i = 0; i < A.size(); ++i) inherit_cards[A[i].first] = A[i].second;
         for (size_t i = 0; i < B.size(); ++i) {
             int nid = B[i].first;
-            int chosen = (coin(rng) == 0) ? inherit_cards[nid] : B[i].second;
+            int chosen = (coin(rng) == 0) ? inherit_cards[nid] : perm[B[i].second];
             inherit_cards[nid] = chosen;
         }
-        auto child = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, prio, &inherit_cards);
+        return true;
+    };
+    auto decode_offspring = [&](Offspring& off) -> std::vector<std::pair<int,int>> {
+        if (!off.child.empty()) return std::move(off.child);
+        if (off.prio.empty()) return {};
+        EO_STAT(++st.decodes);
+        EO_STAT_TIMER(&st.crossover_ms);
+        auto child = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, off.prio, &off.inherit_cards);
         // 对子代进行小比例 EFT 卡局部优化，进一步降低时长但控制耗时
         child = RefineCardsByEFT(child, id2node, card_num, 0.2, rng);
         return child;
     };
 
-    auto mutate = [&](std::vector<std::pair<int,int>>& indiv) -> bool {
-        std::uniform_real_distribution<double> prob(0.0, 1.0);
-        bool changed = false;
-        if (prob(rng) < mutation_rate) {
-            changed = true;
+    auto mutate_with = [&](std::vector<std::pair<int,int>>& indiv, int arm) {
+        EO_STAT_TIMER(&st.mutate_ms);
+        switch (arm) {
+        case kMutCriticalPath:
+            // 只扰动关键链上的节点，使每次评估都可能影响 makespan
+            indiv = CriticalPathMutate(indiv, indeg0, adj, id2node, card_num, cfg.cp_link_ratio, rng);
+            break;
+        case kMutNoise: {
             // 轻微调整优先级（通过位置噪声重建拓扑）和随机修改部分卡分配
             std::uniform_real_distribution<double> prio_noise(0.0, 1.0);
             std::unordered_map<int, double> prio;
@@ -142,76 +352,646 @@ std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all
             indiv = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, prio, &inherit_cards);
             // 局部 EFT 精修代替大量随机卡重分配，降开销增质量
             indiv = RefineCardsByEFT(indiv, id2node, card_num, 0.15, rng);
+            break;
+        }
+        case kMutCardRefine:
+            indiv = RefineCardsByEFT(indiv, id2node, card_num, 0.2, rng);
+            break;
+        default:
+            break;
         }
-        return changed;
+    };
+    // 固定策略：以 mutation_rate 概率变异，其中 cp_mutation_share 走关键链算子，其余走噪声重建
+    auto mutate = [&](std::vector<std::pair<int,int>>& indiv) -> bool {
+        std::uniform_real_distribution<double> prob(0.0, 1.0);
+        if (prob(rng) >= mutation_rate) return false;
+        mutate_with(indiv, prob(rng) < cfg.cp_mutation_share ? kMutCriticalPath : kMutNoise);
+        return true;
     };
 
-    // 进化（仅按时间终止）
-    while (true) {
-        long long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::high_resolution_clock::now() - t_start).count();
-        if (elapsed_ms >= time_budget_ms) break;
-        // 如果已满足目标阈值，提前结束
-        if (best_fit <= required_time) break;
+    PathRelinkStats pr_stats;
+    SurrogateStats sur_stats;
+    bool screen_live = cfg.surrogate_pool > 1;
+    std::vector<Offspring> offspring, offspring_ranked;
+    std::vector<int> dense_idx, prio_idx;
+    const std::vector<const Node*> dense_nodes = DenseNodes(id2node);
+    long long generation = 0;
+    long long ga_evals_start = evals;
+    auto t_ga = std::chrono::high_resolution_clock::now();
+    // 进化：由截止控制器决定何时结束（下一代放不下、达到下界或改进停滞）
+    const long long lower_bound = MakespanLowerBound(indeg0, adj, id2node, card_num);
+    AnytimeController controller(ga_deadline, lower_bound, cfg.deadline_gap, cfg.stall_generations,
+                                 cfg.stall_window_share, cfg.stall_tolerance, cfg.deadline_safety);
+    if (cfg.fixed_work) controller.FixedWork(cfg.generations, cfg.max_evaluations);
+    // 首代开销先验：每个候选的构造与解码约为一个种子的平均构造耗时
+    controller.Prime(std::chrono::duration<double, std::milli>(t_seeds_done - t_seeds).count() / seed_num
+                     * pop_size * std::max(1, cfg.surrogate_pool));
+    // 每代、每个候选使用由 (代数, 候选号) 派生的独立随机数流，结果不依赖之前消耗了多少随机数
+    const CounterRng ga_rng = rng.Fork(0);
+    while (controller.Continue(best_fit, evals - ga_evals_start)) {
+        const CounterRng gen_rng = ga_rng.Fork(static_cast<uint64_t>(generation));
+        rng = gen_rng.Fork(0);
         // 子代集合（复用缓冲）
-        next.clear();
+        next_rows.clear();
         fitness_next.clear();
 
-        // 精英保留（基于适应度缓存，避免全排序）
-        std::vector<int> idx(population.size());
+        justified_next.clear();
+
+        // 精英保留（基于适应度缓存，避免全排序）：只传递行号，不拷贝调度
+        std::vector<int> idx(pop_rows.size());
         std::iota(idx.begin(), idx.end(), 0);
         auto compIdx = [&](int a, int b){ return fitness[a] < fitness[b]; };
+        std::vector<int> elites;
         if (!idx.empty()) {
             if (idx.size() >= 2) {
                 std::nth_element(idx.begin(), idx.begin() + 2, idx.end(), compIdx);
-                next.push_back(population[idx[0]]);
-                fitness_next.push_back(fitness[idx[0]]);
-                if (pop_size > 1) {
-                    next.push_back(population[idx[1]]);
-                    fitness_next.push_back(fitness[idx[1]]);
-                }
+                elites.push_back(idx[0]);
+                if (pop_size > 1) elites.push_back(idx[1]);
             } else {
-                next.push_back(population[idx[0]]);
-                fitness_next.push_back(fitness[idx[0]]);
+                elites.push_back(idx[0]);
+            }
+        }
+        for (int e : elites) {
+            next_rows.push_back(pop_rows[e]);
+            fitness_next.push_back(fitness[e]);
+            justified_next.push_back(justified[e]);
+        }
+        // 精英做前向-后向改进（每个精英只做一次，已收敛的不再重复）；原地改写其所在行，当前代的适应度同步更新
+        if (cfg.fbj_enabled) {
+            EO_STAT_TIMER(&st.refine_ms);
+            for (size_t e = 0; e < next_rows.size(); ++e) {
+                if (justified_next[e]) continue;
+                arena.Load(next_rows[e], buf_a);
+                fitness_next[e] = ForwardBackwardImprove(buf_a, fitness_next[e], id2node, adj,
+                                                         card_num, cfg.fbj_max_iters, &fbj_stats);
+                canonicalize(buf_a);
+                fit_cache.Insert(ScheduleHash(buf_a), fitness_next[e]);
+                arena.Store(next_rows[e], buf_a);
+                justified_next[e] = 1;
+                fitness[elites[e]] = fitness_next[e];
+                justified[elites[e]] = 1;
             }
         }
+        // 子代写入当前代与精英都未占用的行
+        std::fill(row_used.begin(), row_used.end(), 0);
+        for (int r : pop_rows) row_used[r] = 1;
+        int free_row = 0;
 
-        while (static_cast<int>(next.size()) < pop_size) {
-            int parentA_idx = tournament_select_idx(population, fitness);
-            int parentB_idx = tournament_select_idx(population, fitness);
-            auto child = crossover(population[parentA_idx], population[parentB_idx]);
-            if (child.empty()) child = population[parentA_idx]; // 保护：若失败则继承父代
-            bool changed = mutate(child);
-            long long child_fit;
-            if (!changed) {
-                if (schedule_equal(child, population[parentA_idx])) {
-                    child_fit = fitness[parentA_idx];
-                } else if (schedule_equal(child, population[parentB_idx])) {
-                    child_fit = fitness[parentB_idx];
+        // 每个空位生成 surrogate_pool 个交叉候选，按代理评分只解码、评估最优的若干个；
+        // 每 surrogate_audit_interval 代对全部候选完整评估一次，记录代理分与真实 makespan 的秩相关
+        const int need = std::max(0, pop_size - static_cast<int>(next_rows.size()));
+        const int pool = screen_live ? std::max(1, cfg.surrogate_pool) : 1;
+        const bool screen = pool > 1 && need > 0;
+        const bool audit = screen && cfg.surrogate_audit_interval > 0 && generation % cfg.surrogate_audit_interval == 0;
+        offspring.resize(static_cast<size_t>(need) * pool);
+        for (size_t k = 0; k < offspring.size(); ++k) {
+            Offspring& off = offspring[k];
+            off.stream = gen_rng.Fork(k + 1);
+            rng = off.stream.Fork(0);
+            make_offspring(tournament_select_idx(pop_rows, fitness), tournament_select_idx(pop_rows, fitness), off);
+            off.score = 0;
+        }
+        if (screen) {
+            for (auto& off : offspring) {
+                rng = off.stream.Fork(1);
+                auto t_score = std::chrono::high_resolution_clock::now();
+                // 保序交叉的子代已是完整执行序，直接精确模拟
+                if (!off.child.empty()) {
+                    off.score = SimulateOrder(off.child, dense_nodes, card_num);
                 } else {
-                    child_fit = evaluate(child);
+                    off.score = off.prio.empty() ? -1 : SurrogateScore(indeg0, adj, dense_nodes, card_num, off.prio, off.inherit_cards, rng);
                 }
+                if (off.score < 0) off.score = std::numeric_limits<long long>::max();
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_score).count();
+                off.xo_ms += ms;
+                sur_stats.score_ms += ms;
+            }
+            sur_stats.candidates += static_cast<long long>(offspring.size());
+            // 两类候选分开排序、按候选数比例分配空位：保序交叉子代的分数是精确 makespan，
+            // 优先级候选的代理分（非 EFT 列表调度）系统性偏大，混在一起排序会偏向保序交叉
+            dense_idx.clear();
+            prio_idx.clear();
+            for (int k = 0; k < static_cast<int>(offspring.size()); ++k) {
+                (offspring[k].prio.empty() ? dense_idx : prio_idx).push_back(k);
+            }
+            auto by_score = [&](int a, int b){ return offspring[a].score < offspring[b].score; };
+            std::stable_sort(dense_idx.begin(), dense_idx.end(), by_score);
+            std::stable_sort(prio_idx.begin(), prio_idx.end(), by_score);
+            const int total = static_cast<int>(offspring.size());
+            const int dense_num = static_cast<int>(dense_idx.size()), prio_num = static_cast<int>(prio_idx.size());
+            int dense_slots = std::min(dense_num, (2 * need * dense_num + total) / (2 * total));
+            const int prio_slots = std::min(prio_num, need - dense_slots);
+            dense_slots = need - prio_slots;
+            // 入选者排在前 need 位，其余候选（仅核对时解码）随后
+            offspring_ranked.clear();
+            for (int i = 0; i < dense_slots; ++i) offspring_ranked.push_back(std::move(offspring[dense_idx[i]]));
+            for (int i = 0; i < prio_slots; ++i) offspring_ranked.push_back(std::move(offspring[prio_idx[i]]));
+            for (int i = dense_slots; i < dense_num; ++i) offspring_ranked.push_back(std::move(offspring[dense_idx[i]]));
+            for (int i = prio_slots; i < prio_num; ++i) offspring_ranked.push_back(std::move(offspring[prio_idx[i]]));
+            offspring.swap(offspring_ranked);
+        }
+        std::vector<double> audit_score, audit_true;
+        const int decode_num = audit ? static_cast<int>(offspring.size()) : need;
+        for (int c = 0; c < decode_num; ++c) {
+            Offspring& off = offspring[c];
+            rng = off.stream.Fork(2);
+            auto t_decode = std::chrono::high_resolution_clock::now();
+            auto child = decode_offspring(off);
+            if (child.empty()) arena.Load(pop_rows[off.parent_a], child); // 保护：若失败则继承父代
+            long long child_fit;
+            long long decoded_fit = -1; // 解码后、变异前的 makespan（核对代理排序用）
+            if (cfg.bandit_enabled) {
+                // 交叉后先评估一次，把改进分别记到交叉臂（相对较优父代）与变异臂（相对交叉结果）
+                canonicalize(child);
+                long long xo_fit = evaluate_cached(child);
+                off.xo_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_decode).count();
+                xo_bandit.Credit(off.xo_arm, std::min(fitness[off.parent_a], fitness[off.parent_b]) - xo_fit,
+                                 bandit_cost(off.xo_ms));
+                int arm = mut_bandit.Select();
+                auto t_mut = std::chrono::high_resolution_clock::now();
+                mutate_with(child, arm);
+                canonicalize(child);
+                child_fit = evaluate_cached(child);
+                decoded_fit = xo_fit;
+                mut_bandit.Credit(arm, xo_fit - child_fit,
+                                  bandit_cost(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_mut).count()));
             } else {
-                child_fit = evaluate(child);
+                if (audit) {
+                    canonicalize(child);
+                    decoded_fit = evaluate_cached(child);
+                }
+                mutate(child);
+                canonicalize(child);
+                child_fit = evaluate_cached(child);
+            }
+            if (screen) ++sur_stats.decoded;
+            // 只核对代理评分的候选（保序交叉子代的分数本就是精确值）
+            if (audit && !offspring[c].prio.empty()) {
+                audit_score.push_back(static_cast<double>(offspring[c].score));
+                audit_true.push_back(static_cast<double>(decoded_fit));
             }
-            next.push_back(std::move(child));
+            if (c >= need) continue;
+            while (row_used[free_row]) ++free_row;
+            row_used[free_row] = 1;
+            arena.Store(free_row, child);
+            next_rows.push_back(free_row);
             fitness_next.push_back(child_fit);
+            justified_next.push_back(0);
+        }
+        // 被代理筛掉的候选只计耗时、不计改进
+        if (cfg.bandit_enabled) {
+            for (int c = decode_num; c < static_cast<int>(offspring.size()); ++c) {
+                xo_bandit.Credit(offspring[c].xo_arm, 0, bandit_cost(offspring[c].xo_ms));
+            }
+        }
+        if (audit && audit_score.size() >= 2) {
+            ++sur_stats.audits;
+            sur_stats.spearman_sum += SpearmanCorrelation(audit_score, audit_true);
+            if (sur_stats.audits >= cfg.surrogate_min_audits && sur_stats.spearman_sum / sur_stats.audits <= 0) {
+                screen_live = false;
+                sur_stats.disabled_at = generation;
+            }
         }
 
-        population.swap(next);
+        rng = gen_rng.Fork(offspring.size() + 1);
+        pop_rows.swap(next_rows);
         fitness.swap(fitness_next);
+        justified.swap(justified_next);
+        ++generation;
+
+        // 周期性路径重连：在最优的两个精英之间双向行走，最优中间解替换最差个体
+        if (cfg.pr_enabled && cfg.pr_interval > 0 && generation % cfg.pr_interval == 0 && pop_rows.size() >= 3) {
+            EO_STAT_TIMER(&st.refine_ms);
+            std::vector<int> ranked(pop_rows.size());
+            std::iota(ranked.begin(), ranked.end(), 0);
+            std::sort(ranked.begin(), ranked.end(), [&](int a, int b){ return fitness[a] < fitness[b]; });
+            int ea = ranked[0], eb = ranked[1], worst = ranked.back();
+            if (!arena.Equal(pop_rows[ea], pop_rows[eb])) {
+                arena.Load(pop_rows[ea], buf_a);
+                arena.Load(pop_rows[eb], buf_b);
+                std::vector<std::pair<int,int>> relinked, tmp;
+                long long relinked_fit = -1;
+                long long f1 = PathRelink(buf_a, fitness[ea], buf_b, fitness[eb],
+                                          id2node, card_num, cfg.pr_max_evals, &tmp, &pr_stats);
+                if (f1 >= 0) { relinked_fit = f1; relinked.swap(tmp); }
+                long long f2 = PathRelink(buf_b, fitness[eb], buf_a, fitness[ea],
+                                          id2node, card_num, cfg.pr_max_evals, &tmp, &pr_stats);
+                if (f2 >= 0 && (relinked_fit < 0 || f2 < relinked_fit)) { relinked_fit = f2; relinked.swap(tmp); }
+                if (relinked_fit >= 0 && relinked_fit < fitness[worst]) {
+                    canonicalize(relinked);
+                    fit_cache.Insert(ScheduleHash(relinked), relinked_fit);
+                    arena.Store(pop_rows[worst], relinked);
+                    fitness[worst] = relinked_fit;
+                    justified[worst] = 0;
+                }
+            }
+        }
+
         int cur_best_idx = static_cast<int>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
         if (fitness[cur_best_idx] < best_fit) {
+            EO_STAT(++st.improvements);
             best_fit = fitness[cur_best_idx];
-            best = population[cur_best_idx];
+            arena.Load(pop_rows[cur_best_idx], best);
+        }
+    }
+
+    EO_STAT(st.generations += generation);
+    if (cfg.verbose) {
+        double ga_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t_ga).count();
+        long long ga_evals = evals - ga_evals_start;
+        std::cerr << "[GA] nodes=" << node_ids.size()
+                  << " generations=" << generation
+                  << " evals=" << ga_evals
+                  << " time_ms=" << ga_ms
+                  << " evals/s=" << (ga_ms > 0 ? ga_evals * 1000.0 / ga_ms : 0.0)
+                  << " arena_bytes=" << arena.Bytes()
+                  << " best=" << best_fit << std::endl;
+        std::cerr << "[Deadline] stop=" << StopReasonName(controller.reason())
+                  << " generation_ms=" << controller.round_ms()
+                  << " remaining_ms=" << std::chrono::duration<double, std::milli>(
+                         ga_deadline - std::chrono::high_resolution_clock::now()).count()
+                  << " lower_bound=" << lower_bound
+                  << " gap=" << (lower_bound > 0 ? static_cast<double>(best_fit - lower_bound) / lower_bound : 0.0)
+                  << std::endl;
+        std::cerr << "[Cache] lookups=" << fit_cache.lookups()
+                  << " hits=" << fit_cache.hits()
+                  << " hit_rate=" << (fit_cache.lookups() > 0 ? static_cast<double>(fit_cache.hits()) / fit_cache.lookups() : 0.0)
+                  << " size=" << fit_cache.size() << std::endl;
+    }
+
+    if (cfg.verbose && cfg.bandit_enabled) {
+        for (const OperatorBandit* b : {&xo_bandit, &mut_bandit}) {
+            long long total = 0;
+            for (int a = 0; a < b->arms(); ++a) total += b->pulls(a);
+            std::cerr << (b == &xo_bandit ? "[Bandit] crossover" : "[Bandit] mutation");
+            for (int a = 0; a < b->arms(); ++a) {
+                std::cerr << " " << b->name(a) << "=" << b->pulls(a)
+                          << "(" << (total > 0 ? 100.0 * b->pulls(a) / total : 0.0) << "%"
+                          << " gain=" << b->gain(a) << " ms=" << b->ms(a) << ")";
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+    if (cfg.verbose && cfg.surrogate_pool > 1) {
+        std::cerr << "[Surrogate] pool=" << cfg.surrogate_pool
+                  << " candidates=" << sur_stats.candidates
+                  << " decoded=" << sur_stats.decoded
+                  << " audits=" << sur_stats.audits
+                  << " spearman=" << (sur_stats.audits > 0 ? sur_stats.spearman_sum / sur_stats.audits : 0.0)
+                  << " score_ms=" << sur_stats.score_ms
+                  << " disabled_at=" << sur_stats.disabled_at << std::endl;
+    }
+
+    if (cfg.verbose && cfg.fbj_enabled) {
+        std::cerr << "[FBJ] calls=" << fbj_stats.calls
+                  << " improved=" << fbj_stats.improved
+                  << " passes=" << fbj_stats.passes
+                  << " makespan_removed=" << fbj_stats.gain << std::endl;
+    }
+
+    if (cfg.verbose && cfg.pr_enabled) {
+        std::cerr << "[PR] generations=" << generation
+                  << " relinks=" << pr_stats.calls
+                  << " evals=" << pr_stats.evals
+                  << " improved=" << pr_stats.improved
+                  << " gain=" << pr_stats.gain << std::endl;
+    }
+
+    // LNS：窗口精确重排，在剩余预算内持续改进 best
+    // 已达下界时无需 LNS
+    if (cfg.lns_enabled && lns_budget_ms > 0 && best_fit > lower_bound) {
+        auto now = std::chrono::high_resolution_clock::now();
+        auto deadline = std::min(t_start + std::chrono::milliseconds(time_budget_ms),
+                                 now + std::chrono::milliseconds(lns_budget_ms));
+        LNSStats lns_stats;
+        {
+            EO_STAT_TIMER(&st.refine_ms);
+            best_fit = ImproveByLNS(best, best_fit, id2node, card_num, cfg.lns_window,
+                                    cfg.lns_node_limit, cfg.lns_leaf_limit, LnsWindowLimit(cfg), deadline, rng, &lns_stats);
+        }
+        EO_STAT(st.improvements += lns_stats.improved);
+        if (cfg.verbose) {
+            double sec = lns_stats.elapsed_ms / 1000.0;
+            long long gain = lns_stats.start_fit - lns_stats.end_fit;
+            std::cerr << "[LNS] windows=" << lns_stats.windows
+                      << " improved=" << lns_stats.improved
+                      << " bnb_nodes=" << lns_stats.bnb_nodes
+                      << " makespan " << lns_stats.start_fit << " -> " << lns_stats.end_fit
+                      << " time_ms=" << lns_stats.elapsed_ms
+                      << " gain/s=" << (sec > 0 ? gain / sec : 0.0) << std::endl;
         }
-        // 满足目标阈值则提前结束
-        if (best_fit <= required_time) break;
     }
 
+    if (stats) EO_STAT(stats->Merge(st));
+
     // 将最终 best 转换为 size_t 类型返回
     std::vector<std::pair<size_t,size_t>> result;
     result.reserve(best.size());
     for (const auto& p : best) result.emplace_back(static_cast<size_t>(p.first), static_cast<size_t>(p.second));
     return result;
+}
+
+// 多级模式：重边匹配逐层粗化到 ml_coarsest_nodes 以下，最粗层运行完整流程（占 ml_coarse_share 预算），
+// 再逐层投影回细图，每层做一次全量 EFT 选卡与前向-后向精修，最细层用剩余时间做 LNS
+std::vector<std::pair<size_t,size_t>> SolveMultilevel(const std::vector<Node*>& all_nodes, int card_num,
+                                                      const GAConfig& cfg,
+                                                      std::chrono::high_resolution_clock::time_point t_start,
+                                                      long long time_budget_ms,
+                                                      long long max_exec,
+                                                      SolveStats* stats) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsed_ms = [&]() { return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count(); };
+    std::vector<ContractedGraph> levels;
+    auto level_nodes = [&](size_t k) -> const std::vector<Node*>& {
+        return k == 0 ? all_nodes : levels[k - 1].nodes;
+    };
+    while (static_cast<int>(level_nodes(levels.size()).size()) > cfg.ml_coarsest_nodes) {
+        size_t fine_size = level_nodes(levels.size()).size();
+        ContractedGraph g = CoarsenByMatching(level_nodes(levels.size()), max_exec);
+        if (g.nodes.size() > fine_size * 0.95) break; // 几乎无法再合并
+        levels.push_back(std::move(g));
+    }
+    if (levels.empty()) return SolveSchedule(all_nodes, card_num, cfg, t_start, time_budget_ms, stats);
+    if (cfg.verbose) {
+        std::cerr << "[ML] levels:";
+        for (size_t k = 0; k <= levels.size(); ++k) std::cerr << " " << level_nodes(k).size();
+        std::cerr << " coarsen_ms=" << elapsed_ms() << std::endl;
+    }
+
+    auto coarse = SolveSchedule(level_nodes(levels.size()), card_num, cfg, t_start,
+                                static_cast<long long>(time_budget_ms * cfg.ml_coarse_share), stats);
+    SolveStats st; // 逐层精修的耗时
+    auto deadline = t_start + std::chrono::milliseconds(time_budget_ms);
+    CounterRng rng = MakeRng(cfg, 1);
+    for (size_t k = levels.size(); k-- > 0; ) {
+        auto projected = ExpandChains(levels[k], coarse);
+        std::unordered_map<int, const Node*> id2node;
+        std::unordered_map<int, int> indeg0;
+        std::unordered_map<int, std::vector<int>> adj;
+        BuildGraph(level_nodes(k), id2node, indeg0, adj);
+        std::vector<const Node*> dense = DenseNodes(id2node);
+
+        std::vector<std::pair<int,int>> indiv;
+        indiv.reserve(projected.size());
+        for (const auto& p : projected) indiv.emplace_back(static_cast<int>(p.first), static_cast<int>(p.second));
+        long long projected_fit = SimulateOrder(indiv, dense, card_num);
+        long long fit = projected_fit;
+        if (Clock::now() < deadline) {
+            // 以投影位置为优先级重新做 EFT 列表调度，允许细图上已就绪的节点提前
+            std::unordered_map<int,double> prio;
+            std::unordered_map<int,int> inherit_cards;
+            for (size_t i = 0; i < indiv.size(); ++i) {
+                prio[indiv[i].first] = static_cast<double>(i);
+                inherit_cards[indiv[i].first] = indiv[i].second;
+            }
+            auto rebuilt = TopoByPriorityWithEFT(indeg0, adj, id2node, card_num, rng, prio, &inherit_cards);
+            long long rebuilt_fit = rebuilt.empty() ? -1 : SimulateOrder(rebuilt, dense, card_num);
+            auto refined = RefineCardsByEFT(indiv, id2node, card_num, 1.0, rng);
+            long long refined_fit = SimulateOrder(refined, dense, card_num);
+            if (refined_fit < fit) { indiv.swap(refined); fit = refined_fit; }
+            if (rebuilt_fit >= 0 && rebuilt_fit < fit) { indiv.swap(rebuilt); fit = rebuilt_fit; }
+        }
+        // 粗图模型会串行化合并节点的扇出，通信占比高时投影可能劣于细图直接解码；最细层与插入式 HEFT 比较兜底
+        if (k == 0 && Clock::now() < deadline) {
+            auto direct = BuildInsertionIndividual(indeg0, adj, id2node, ComputeUpwardRank(indeg0, adj, id2node),
+                                                   card_num, nullptr);
+            long long direct_fit = direct.empty() ? -1 : SimulateOrder(direct, dense, card_num);
+            if (direct_fit >= 0 && direct_fit < fit) { indiv.swap(direct); fit = direct_fit; }
+        }
+        if (cfg.fbj_enabled && Clock::now() < deadline) {
+            EO_STAT_TIMER(&st.refine_ms);
+            fit = ForwardBackwardImprove(indiv, fit, id2node, adj, card_num, cfg.fbj_max_iters, nullptr);
+        }
+        if (k == 0 && cfg.lns_enabled && Clock::now() < deadline) {
+            EO_STAT_TIMER(&st.refine_ms);
+            fit = ImproveByLNS(indiv, fit, id2node, card_num, cfg.lns_window,
+                               cfg.lns_node_limit, cfg.lns_leaf_limit, LnsWindowLimit(cfg), deadline, rng, nullptr);
+        }
+        if (cfg.verbose) {
+            std::cerr << "[ML] level=" << k << " nodes=" << dense.size()
+                      << " projected=" << projected_fit << " refined=" << fit
+                      << " t_ms=" << elapsed_ms() << std::endl;
+        }
+        coarse.clear();
+        for (const auto& p : indiv) coarse.emplace_back(static_cast<size_t>(p.first), static_cast<size_t>(p.second));
+    }
+    if (stats) EO_STAT(stats->Merge(st));
+    return coarse;
+}
+
+std::vector<std::pair<size_t,size_t>> SolveGraph(const std::vector<Node*>& all_nodes, int card_num,
+                                                 const GAConfig& cfg,
+                                                 std::chrono::high_resolution_clock::time_point t_start,
+                                                 long long time_budget_ms,
+                                                 long long max_exec,
+                                                 SolveStats* stats);
+
+// 弱连通分量分解：分量按节点数 LPT 装入至多 comp_max_groups 组，各组作为独立子图并行求解
+// （共占 comp_time_share 预算，按节点数分配），子调度按负载映射到全局卡并按开始时间交错合并；
+// 合并结果与整图插入式 HEFT 比较后，剩余时间做整图 LNS
+std::vector<std::pair<size_t,size_t>> SolveByComponents(const std::vector<Node*>& all_nodes, int card_num,
+                                                        const GAConfig& cfg,
+                                                        std::chrono::high_resolution_clock::time_point t_start,
+                                                        long long time_budget_ms,
+                                                        long long max_exec,
+                                                        const std::vector<std::vector<int>>& comps,
+                                                        SolveStats* stats) {
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsed_ms = [&]() { return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count(); };
+
+    const int group_num = std::min(static_cast<int>(comps.size()), std::max(1, cfg.comp_max_groups));
+    std::vector<int> by_size(comps.size());
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::stable_sort(by_size.begin(), by_size.end(), [&](int a, int b){ return comps[a].size() > comps[b].size(); });
+    std::vector<std::vector<int>> groups(group_num);
+    for (int c : by_size) {
+        auto smallest = std::min_element(groups.begin(), groups.end(),
+            [](const std::vector<int>& a, const std::vector<int>& b){ return a.size() < b.size(); });
+        smallest->insert(smallest->end(), comps[c].begin(), comps[c].end());
+    }
+    const std::vector<const Node*> const_nodes(all_nodes.begin(), all_nodes.end());
+    std::vector<ContractedGraph> subs;
+    subs.reserve(group_num);
+    for (auto& ids : groups) {
+        std::sort(ids.begin(), ids.end());
+        subs.push_back(InducedSubgraph(const_nodes, ids));
+    }
+
+    // 子问题并行求解：线程数不超过硬件并发数，多余的组排队；预算按节点数比例分给各组
+    GAConfig sub_cfg = cfg;
+    sub_cfg.comp_enabled = false;
+    sub_cfg.verbose = false;
+    const int workers = std::max(1, std::min<int>(group_num, static_cast<int>(std::thread::hardware_concurrency())));
+    const long long comp_budget_ms = static_cast<long long>(time_budget_ms * cfg.comp_time_share);
+    std::vector<std::vector<std::pair<int,int>>> parts(group_num);
+    std::vector<SolveStats> group_stats(group_num); // 各组单独累计，汇总顺序与线程无关
+    std::atomic<int> next_group(0);
+    auto worker = [&]() {
+        for (int g = next_group++; g < group_num; g = next_group++) {
+            long long share = std::min(comp_budget_ms,
+                comp_budget_ms * workers * static_cast<long long>(subs[g].nodes.size()) / static_cast<long long>(all_nodes.size()));
+            // 每组使用由组号派生的随机数流，结果与线程数及组的调度先后无关
+            GAConfig group_cfg = sub_cfg;
+            group_cfg.rng_stream = cfg.rng_stream * (cfg.comp_max_groups + 1) + g + 1;
+            auto local = SolveGraph(subs[g].nodes, card_num, group_cfg, Clock::now(), share, max_exec, &group_stats[g]);
+            for (const auto& p : ExpandChains(subs[g], local)) {
+                parts[g].emplace_back(static_cast<int>(p.first), static_cast<int>(p.second));
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int w = 1; w < workers; ++w) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    double solve_ms = elapsed_ms();
+    SolveStats st;
+    for (const auto& gs : group_stats) st.Merge(gs);
+
+    std::unordered_map<int, const Node*> id2node;
+    std::unordered_map<int, int> indeg0;
+    std::unordered_map<int, std::vector<int>> adj;
+    BuildGraph(all_nodes, id2node, indeg0, adj);
+    std::vector<const Node*> dense = DenseNodes(id2node);
+    CounterRng rng = MakeRng(cfg, 2);
+    auto deadline = t_start + std::chrono::milliseconds(time_budget_ms);
+
+    // 合并后的整图精修按合并耗时预测（均为 O(N·卡数) 量级），预计越过截止时间则跳过；合并结果为空时总会构造插入式 HEFT
+    auto t_merge = Clock::now();
+    auto best = MergeComponentSchedules(indeg0, adj, id2node, parts, card_num);
+    long long merged_fit = best.empty() ? -1 : SimulateOrder(best, dense, card_num);
+    const auto step = Clock::now() - t_merge;
+    long long fit = merged_fit;
+    long long refined_fit = -1, direct_fit = -1;
+    if (fit < 0 || Clock::now() + step <= deadline) {
+        auto refined = RefineCardsByEFT(best, id2node, card_num, 1.0, rng);
+        refined_fit = refined.empty() ? -1 : SimulateOrder(refined, dense, card_num);
+        if (refined_fit >= 0 && (fit < 0 || refined_fit < fit)) { best.swap(refined); fit = refined_fit; }
+    }
+    if (fit < 0 || Clock::now() + step <= deadline) {
+        auto direct = BuildInsertionIndividual(indeg0, adj, id2node, ComputeUpwardRank(indeg0, adj, id2node),
+                                               card_num, nullptr);
+        direct_fit = direct.empty() ? -1 : SimulateOrder(direct, dense, card_num);
+        if (direct_fit >= 0 && (fit < 0 || direct_fit < fit)) { best.swap(direct); fit = direct_fit; }
+    }
+    if (cfg.fbj_enabled && Clock::now() < deadline) {
+        EO_STAT_TIMER(&st.refine_ms);
+        fit = ForwardBackwardImprove(best, fit, id2node, adj, card_num, cfg.fbj_max_iters, nullptr);
+    }
+    if (cfg.lns_enabled && Clock::now() < deadline) {
+        EO_STAT_TIMER(&st.refine_ms);
+        fit = ImproveByLNS(best, fit, id2node, card_num, cfg.lns_window,
+                           cfg.lns_node_limit, cfg.lns_leaf_limit, LnsWindowLimit(cfg), deadline, rng, nullptr);
+    }
+    if (cfg.verbose) {
+        std::cerr << "[Comp] components=" << comps.size() << " groups=" << group_num
+                  << " workers=" << workers << " solve_ms=" << solve_ms
+                  << " merged=" << merged_fit << " refined=" << refined_fit
+                  << " heft_insert=" << direct_fit << " final=" << fit
+                  << " t_ms=" << elapsed_ms() << std::endl;
+    }
+    if (stats) EO_STAT(stats->Merge(st));
+
+    std::vector<std::pair<size_t,size_t>> result;
+    result.reserve(best.size());
+    for (const auto& p : best) result.emplace_back(static_cast<size_t>(p.first), static_cast<size_t>(p.second));
+    return result;
+}
+
+// 按图结构选择分量分解、多级求解或平铺求解
+std::vector<std::pair<size_t,size_t>> SolveGraph(const std::vector<Node*>& all_nodes, int card_num,
+                                                 const GAConfig& cfg,
+                                                 std::chrono::high_resolution_clock::time_point t_start,
+                                                 long long time_budget_ms,
+                                                 long long max_exec,
+                                                 SolveStats* stats) {
+    if (cfg.comp_enabled) {
+        auto comps = WeakComponents(all_nodes);
+        size_t largest = 0;
+        for (const auto& c : comps) largest = std::max(largest, c.size());
+        if (comps.size() > 1 && largest <= all_nodes.size() * cfg.comp_max_share) {
+            return SolveByComponents(all_nodes, card_num, cfg, t_start, time_budget_ms, max_exec, comps, stats);
+        }
+    }
+    if (cfg.ml_enabled && static_cast<int>(all_nodes.size()) > cfg.ml_min_nodes) {
+        return SolveMultilevel(all_nodes, card_num, cfg, t_start, time_budget_ms, max_exec, stats);
+    }
+    return SolveSchedule(all_nodes, card_num, cfg, t_start, time_budget_ms, stats);
+}
+
+} // namespace
+
+std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all_nodes, int card_num) {
+    return ExecuteOrder(all_nodes, card_num, 0);
+}
+
+std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all_nodes, int card_num,
+                                                   long long deadline_ms) {
+    return ExecuteOrderWithStats(all_nodes, card_num, deadline_ms).order;
+}
+
+ScheduleWithStats ExecuteOrderWithStats(const std::vector<Node*>& all_nodes, int card_num,
+                                        long long deadline_ms) {
+    ScheduleWithStats result;
+    if (card_num <= 0 || all_nodes.empty()) return result;
+
+    // 从进入 ExecuteOrder 开始计时（含读取配置）
+    auto t_start = std::chrono::high_resolution_clock::now();
+
+    // 内置默认配置，可由环境变量指定的配置文件（含按图类别的调参结果）与逐项变量覆盖；
+    // auto_select 时先按图特征选择求解策略，再叠加显式配置
+    const std::string graph_class = GraphClass(all_nodes);
+    GAConfig cfg;
+    ApplyConfigEnv(cfg, graph_class);
+    if (cfg.auto_select) {
+        GraphFeatures features = ExtractGraphFeatures(all_nodes, card_num);
+        GAConfig selected;
+        StrategyChoice choice = SelectStrategy(features, selected);
+        ApplyConfigEnv(selected, graph_class, false);
+        cfg = selected;
+        if (cfg.verbose) {
+            std::cerr << "[Select] strategy=" << choice.name
+                      << (choice.changes.empty() ? "" : " ") << choice.changes
+                      << " | " << FormatGraphFeatures(features) << std::endl;
+        }
+    }
+    if (deadline_ms > 0) cfg.deadline_ms = deadline_ms;
+
+    // 时间预算：显式截止时间优先；否则 50,000 点 ≈ 1 分钟，按原图点数线性缩放，单位毫秒；搜索停滞时会提前返回
+    long long time_budget_ms = cfg.deadline_ms > 0
+        ? cfg.deadline_ms
+        : static_cast<long long>(60000.0 * (static_cast<double>(all_nodes.size()) / 50000.0));
+    // 固定工作量模式：墙钟预算放宽到不会触发，各阶段只按代数、评估数与窗口数结束
+    if (cfg.fixed_work) time_budget_ms = kFixedWorkBudgetMs;
+    // 预留尾部时间给结果展开与清理，搜索阶段在剩余部分内结束
+    time_budget_ms = static_cast<long long>(time_budget_ms * (1.0 - cfg.deadline_reserve_share));
+
+    // 合并节点（链收缩、多级粗化）时单个超节点的 exec 上限
+    long long total_exec = 0;
+    for (const Node* n : all_nodes) if (n) total_exec += n->exec_time();
+    long long max_exec = static_cast<long long>(cfg.chain_max_load_share * total_exec / card_num);
+
+    if (!cfg.chain_contraction) {
+        result.order = SolveGraph(all_nodes, card_num, cfg, t_start, time_budget_ms, max_exec, &result.stats);
+    } else {
+        // 线性链收缩：在超节点图上搜索，结果展开回原节点
+        ContractedGraph graph = ContractChains(all_nodes, max_exec);
+        if (cfg.verbose) {
+            std::cerr << "[Chain] nodes " << all_nodes.size() << " -> " << graph.nodes.size()
+                      << " chains=" << graph.chains << std::endl;
+        }
+        if (graph.nodes.size() == all_nodes.size()) {
+            result.order = SolveGraph(all_nodes, card_num, cfg, t_start, time_budget_ms, max_exec, &result.stats);
+        } else {
+            result.order = ExpandChains(graph, SolveGraph(graph.nodes, card_num, cfg, t_start, time_budget_ms, max_exec,
+                                                          &result.stats));
+        }
+    }
+
+    EO_STAT(result.stats.total_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - t_start).count());
+#ifdef EO_STATS
+    if (cfg.verbose) std::cerr << "[Stats] " << FormatSolveStats(result.stats) << std::endl;
+#endif
+    return result;
 }
\ No newline at end of file
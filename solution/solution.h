@@ -4,10 +4,26 @@
 #include <vector>
 #include <utility>
 #include "node.h"
+#include "Stats.h"
 
 // 接口：根据算子与卡数量产生执行序列 (node_id, card_id)
 std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all_nodes, int card_num);
 
+// 接口：同上，deadline_ms > 0 时在进入后 deadline_ms 毫秒内返回（不超时），
+// 否则取配置中的 deadline_ms（见 ConfigIO.h 的环境变量），仍未设置则按节点数缩放默认预算
+std::vector<std::pair<size_t,size_t>> ExecuteOrder(const std::vector<Node*>& all_nodes, int card_num,
+                                                   long long deadline_ms);
+
+// 执行序列与求解统计（统计项只在以 EO_STATS 编译时累计，否则全为 0）
+struct ScheduleWithStats {
+    std::vector<std::pair<size_t,size_t>> order;
+    SolveStats stats;
+};
+
+// 接口：同 ExecuteOrder，同时返回求解统计；以 EO_STATS 编译且 verbose 时另输出 [Stats] 行到 stderr
+ScheduleWithStats ExecuteOrderWithStats(const std::vector<Node*>& all_nodes, int card_num,
+                                        long long deadline_ms = 0);
+
 // 接口：根据给定的执行序列计算总时长（makespan）
 long long CalcTotalDuration(const std::vector<std::pair<size_t, size_t>> &order_list,
                         const std::vector<Node *> &nodes,
@@ -0,0 +1,208 @@
+// 离线超参数调优：在图语料上对 GAConfig 做逐次减半（successive halving），按图类别输出最优配置。
+// 用法：
+//   eo_autotune [选项] --out DIR graph1.txt graph2.txt ...
+//     --jobs N        并行子进程数（默认硬件并发数）
+//     --configs K     每个类别的初始候选数，含默认配置（默认 16）
+//     --eta E         每轮保留前 1/E，预算乘 E（默认 3）
+//     --budget-ms B   第一轮每次求解的截止时间（默认 200）
+//     --seed S        候选采样与求解种子（默认 1）
+//   eo_autotune --eval GRAPH   子进程模式：按环境变量加载配置求解 GRAPH，向 stdout 输出 makespan
+// 候选在独立进程中以 EO_CONFIG=<候选配置文件> 运行本程序的 --eval 模式，与线上加载路径一致。
+// 每个类别的胜者写入 DIR/<类别>.cfg，运行时设置 EO_CONFIG_DIR=DIR 启用
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConfigIO.h"
+#include "Random.h"
+#include "solution.h"
+#include "utils.h"
+
+namespace {
+
+struct Options {
+    int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int configs = 16;
+    int eta = 3;
+    long long budget_ms = 200;
+    int seed = 1;
+    std::string out;
+    std::vector<std::string> graphs;
+};
+
+struct Candidate {
+    GAConfig cfg;
+    std::string path;   // 本轮写出的配置文件
+    double score = 0.0; // 各图 makespan / 本轮该图最优 的均值，越小越好
+};
+
+// 搜索空间：只采样对质量影响较大的参数，其余保持默认。
+// 配置文件只写出这些字段，其余字段仍取内置默认与按图特征选择的策略（见 Strategy.h）
+const std::vector<std::string> kTunedFields = {
+    "pop_size", "mutation_rate", "tournament_k", "surrogate_pool", "bandit_enabled", "bandit_explore",
+    "cp_mutation_share", "beam_width", "pr_interval", "stall_generations", "lns_time_share", "lns_window",
+};
+
+GAConfig SampleConfig(CounterRng& rng) {
+    auto pick = [&](const std::vector<int>& xs) {
+        return xs[std::uniform_int_distribution<size_t>(0, xs.size() - 1)(rng)];
+    };
+    auto uniform = [&](double a, double b) { return std::uniform_real_distribution<double>(a, b)(rng); };
+    GAConfig c;
+    c.pop_size = pick({4, 5, 6, 8, 12});
+    c.mutation_rate = uniform(0.2, 0.8);
+    c.tournament_k = pick({2, 3, 4});
+    c.surrogate_pool = pick({1, 2, 3, 4});
+    c.bandit_enabled = pick({0, 1}) != 0;
+    c.bandit_explore = uniform(0.2, 1.0);
+    c.cp_mutation_share = uniform(0.3, 0.9);
+    c.beam_width = pick({0, 2, 4, 8});
+    c.pr_interval = pick({3, 5, 10});
+    c.stall_generations = pick({15, 30, 60});
+    c.lns_time_share = uniform(0.1, 0.5);
+    c.lns_window = pick({5, 6, 7, 8});
+    return c;
+}
+
+// 子进程求解一次，返回 makespan；失败返回 -1
+long long RunChild(const std::string& self, const std::string& cfg_path, const std::string& graph) {
+    std::string cmd = "EO_CONFIG='" + cfg_path + "' '" + self + "' --eval '" + graph + "' 2>/dev/null";
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (!pipe) return -1;
+    long long makespan = -1;
+    if (std::fscanf(pipe, "%lld", &makespan) != 1) makespan = -1;
+    pclose(pipe);
+    return makespan;
+}
+
+int EvalMain(const std::string& graph) {
+    auto inputs = GetInputs(graph);
+    std::vector<Node*>& nodes = std::get<0>(inputs);
+    int card_num = static_cast<int>(std::get<1>(inputs));
+    auto order = ExecuteOrder(nodes, card_num);
+    long long makespan = CalcTotalDuration(order, nodes, static_cast<size_t>(card_num));
+    std::cout << makespan << std::endl;
+    for (Node* n : nodes) delete n;
+    return makespan >= 0 ? 0 : 1;
+}
+
+// 单个类别的逐次减半：每轮所有 (候选, 图) 组合并行求解，按相对 makespan 排名保留前 1/eta
+Candidate TuneClass(const Options& opt, const std::string& self, const std::string& cls,
+                    const std::vector<std::string>& graphs, CounterRng& rng) {
+    std::vector<Candidate> cands(1);
+    while (static_cast<int>(cands.size()) < opt.configs) {
+        Candidate c;
+        c.cfg = SampleConfig(rng);
+        cands.push_back(c);
+    }
+    long long budget = opt.budget_ms;
+    for (int rung = 0;; ++rung) {
+        for (size_t i = 0; i < cands.size(); ++i) {
+            GAConfig run = cands[i].cfg;
+            run.deadline_ms = budget;
+            run.seed = opt.seed;
+            run.verbose = false;
+            cands[i].path = opt.out + "/." + cls + "_c" + std::to_string(i) + ".cfg";
+            std::vector<std::string> run_fields = kTunedFields;
+            run_fields.insert(run_fields.end(), {"deadline_ms", "seed", "verbose"});
+            std::ofstream(cands[i].path) << FormatConfig(run, run_fields);
+        }
+        const size_t tasks = cands.size() * graphs.size();
+        std::vector<long long> makespan(tasks, -1);
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t t = next++; t < tasks; t = next++) {
+                makespan[t] = RunChild(self, cands[t / graphs.size()].path, graphs[t % graphs.size()]);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int j = 0; j < std::min<int>(opt.jobs, static_cast<int>(tasks)); ++j) pool.emplace_back(worker);
+        for (auto& th : pool) th.join();
+
+        // 失败的求解按最优值的 10 倍计
+        for (size_t g = 0; g < graphs.size(); ++g) {
+            long long best = LLONG_MAX;
+            for (size_t i = 0; i < cands.size(); ++i) {
+                long long m = makespan[i * graphs.size() + g];
+                if (m >= 0) best = std::min(best, m);
+            }
+            for (size_t i = 0; i < cands.size(); ++i) {
+                if (g == 0) cands[i].score = 0.0;
+                long long m = makespan[i * graphs.size() + g];
+                double rel = (m >= 0 && best > 0 && best != LLONG_MAX) ? static_cast<double>(m) / best : 10.0;
+                cands[i].score += rel / graphs.size();
+            }
+        }
+        for (const auto& c : cands) std::remove(c.path.c_str());
+        std::stable_sort(cands.begin(), cands.end(),
+                         [](const Candidate& a, const Candidate& b) { return a.score < b.score; });
+        std::cerr << "[Autotune] class=" << cls << " rung=" << rung << " budget_ms=" << budget
+                  << " candidates=" << cands.size() << " best_score=" << cands[0].score << std::endl;
+        // 只剩一个幸存者时已无可比较，不再多跑一轮
+        cands.resize(std::max<size_t>(1, cands.size() / opt.eta));
+        if (cands.size() == 1) break;
+        budget *= opt.eta;
+    }
+    return cands[0];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--eval") return EvalMain(argv[2]);
+
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+        if (arg == "--jobs") opt.jobs = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--configs") opt.configs = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--eta") opt.eta = std::max(2, std::atoi(value().c_str()));
+        else if (arg == "--budget-ms") opt.budget_ms = std::max(1LL, std::atoll(value().c_str()));
+        else if (arg == "--seed") opt.seed = std::atoi(value().c_str());
+        else if (arg == "--out") opt.out = value();
+        else opt.graphs.push_back(arg);
+    }
+    if (opt.out.empty() || opt.graphs.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--jobs N] [--configs K] [--eta E] [--budget-ms B] [--seed S]"
+                  << " --out DIR graph.txt..." << std::endl;
+        return 1;
+    }
+    char self[4096] = {0};
+    if (realpath(argv[0], self) == nullptr) {
+        std::cerr << "cannot resolve " << argv[0] << std::endl;
+        return 1;
+    }
+
+    // 按类别分组语料（只需节点数）
+    std::map<std::string, std::vector<std::string>> by_class;
+    for (const auto& g : opt.graphs) {
+        auto inputs = GetInputs(g);
+        std::vector<Node*>& nodes = std::get<0>(inputs);
+        by_class[GraphClass(nodes)].push_back(g);
+        for (Node* n : nodes) delete n;
+    }
+
+    CounterRng rng(static_cast<uint64_t>(opt.seed));
+    for (const auto& kv : by_class) {
+        Candidate best = TuneClass(opt, self, kv.first, kv.second, rng);
+        std::string path = opt.out + "/" + kv.first + ".cfg";
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "cannot write " << path << std::endl;
+            return 1;
+        }
+        out << "# eo_autotune: class=" << kv.first << " graphs=" << kv.second.size()
+            << " score=" << best.score << "\n" << FormatConfig(best.cfg, kTunedFields);
+        std::cerr << "[Autotune] wrote " << path << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// 离线训练列表调度优先级权重：在图语料上用 TopoByPriorityWithEFT 解码加权优先级，
+// 目标为各图 makespan 相对纯 upward-rank 优先级（HEFT）之比的均值，
+// 从 HEFT 权重出发做步长递减的坐标搜索（权重按 L1 归一化，允许为负）。
+// 用法：
+//   eo_train_priority [--passes N] [--jobs J] [--out FILE] graph1.txt graph2.txt ...
+// 输出 prio_w_<特征> = 值 的配置行，可作为 EO_CONFIG 文件加载，或并入 eo_autotune 输出的类别配置
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "GAInit.h"
+#include "PriorityRule.h"
+#include "Simulator.h"
+#include "utils.h"
+
+namespace {
+
+struct Graph {
+    std::string name;
+    std::vector<Node*> nodes;
+    int card_num = 0;
+    std::unordered_map<int, const Node*> id2node;
+    std::unordered_map<int,int> indeg0;
+    std::unordered_map<int,std::vector<int>> adj;
+    std::vector<const Node*> dense;
+    std::unordered_map<int, PriorityFeatures> features;
+    long long heft = 0; // 纯 upward-rank 权重的 makespan，作为归一化基准
+};
+
+long long Decode(const Graph& g, const PriorityWeights& w) {
+    CounterRng rng(0);
+    auto order = TopoByPriorityWithEFT(g.indeg0, g.adj, g.id2node, g.card_num, rng, WeightedPriority(g.features, w), nullptr);
+    return order.empty() ? -1 : SimulateOrder(order, g.dense, g.card_num);
+}
+
+void Normalize(PriorityWeights& w) {
+    double l1 = 0.0;
+    for (double x : w) l1 += std::fabs(x);
+    if (l1 > 0.0) for (double& x : w) x /= l1;
+}
+
+// 语料上的目标值：makespan / HEFT makespan 的均值，各图并行解码
+double Objective(const std::vector<Graph>& graphs, const PriorityWeights& w, int jobs) {
+    std::vector<double> ratio(graphs.size(), 0.0);
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < graphs.size(); i = next++) {
+            long long ms = Decode(graphs[i], w);
+            ratio[i] = (ms > 0 && graphs[i].heft > 0) ? static_cast<double>(ms) / graphs[i].heft : 10.0;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int j = 1; j < std::min<int>(jobs, static_cast<int>(graphs.size())); ++j) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    double sum = 0.0;
+    for (double r : ratio) sum += r;
+    return graphs.empty() ? 0.0 : sum / graphs.size();
+}
+
+std::string FormatWeights(const PriorityWeights& w) {
+    std::ostringstream os;
+    for (int i = 0; i < kPriorityFeatureNum; ++i) os << "prio_w_" << PriorityFeatureName(i) << " = " << w[i] << "\n";
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int passes = 12;
+    int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::string out;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+        if (arg == "--passes") passes = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--jobs") jobs = std::max(1, std::atoi(value().c_str()));
+        else if (arg == "--out") out = value();
+        else files.push_back(arg);
+    }
+    if (files.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--passes N] [--jobs J] [--out FILE] graph.txt..." << std::endl;
+        return 1;
+    }
+
+    PriorityWeights heft{};
+    heft[kFeatUpRank] = 1.0;
+    std::vector<Graph> graphs(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        Graph& g = graphs[i];
+        g.name = files[i];
+        auto inputs = GetInputs(files[i]);
+        g.nodes = std::get<0>(inputs);
+        g.card_num = static_cast<int>(std::get<1>(inputs));
+        for (const Node* n : g.nodes) g.id2node[n->id()] = n;
+        for (const Node* n : g.nodes) {
+            g.indeg0[n->id()] += 0;
+            for (const Node* pred : n->inputs()) {
+                ++g.indeg0[n->id()];
+                g.adj[pred->id()].push_back(n->id());
+            }
+        }
+        g.dense = DenseNodes(g.id2node);
+        g.features = ComputePriorityFeatures(g.indeg0, g.adj, g.id2node);
+        g.heft = Decode(g, heft);
+    }
+
+    // 坐标搜索：每轮对每个特征尝试 ±step，接受改进；整轮无改进则步长减半
+    PriorityWeights best = heft;
+    double best_obj = Objective(graphs, best, jobs);
+    double step = 0.5;
+    for (int pass = 0; pass < passes && step >= 1.0 / 64; ++pass) {
+        bool improved = false;
+        for (int f = 0; f < kPriorityFeatureNum; ++f) {
+            for (double sign : {1.0, -1.0}) {
+                PriorityWeights w = best;
+                w[f] += sign * step;
+                Normalize(w);
+                double obj = Objective(graphs, w, jobs);
+                if (obj < best_obj - 1e-9) {
+                    best = w;
+                    best_obj = obj;
+                    improved = true;
+                }
+            }
+        }
+        std::cerr << "[Train] pass=" << pass << " step=" << step << " objective=" << best_obj << std::endl;
+        if (!improved) step /= 2;
+    }
+
+    for (const Graph& g : graphs) {
+        std::cerr << "[Train] " << g.name << " heft=" << g.heft << " learned=" << Decode(g, best) << std::endl;
+    }
+    std::string text = "# eo_train_priority: graphs=" + std::to_string(graphs.size()) +
+                       " objective=" + std::to_string(best_obj) + "\n" + FormatWeights(best);
+    if (out.empty()) {
+        std::cout << text;
+    } else {
+        std::ofstream(out) << text;
+    }
+    for (Graph& g : graphs) for (Node* n : g.nodes) delete n;
+    return 0;
+}